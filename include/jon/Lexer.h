@@ -2,10 +2,22 @@
 #define JON_LEXER_H
 
 #include <string>
+#include <string_view>
 #include <stdexcept>
+#include <type_traits>
 #include <vector>
+#include <array>
 #include <iostream>
 #include <assert.h>
+#include <string.h>
+
+#if defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) and defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
 
 #include "utils.h"
 #include "error.h"
@@ -17,8 +29,6 @@ namespace jacylang {
     enum class TokenKind {
         Eof,
 
-        NL,
-
         // Punctuations
         Comma,
         Colon,
@@ -60,90 +70,74 @@ namespace jacylang {
 
         Span(pos_t pos, len_t len) : pos(pos), len(len) {}
 
-        const pos_t pos;
-        const len_t len;
+        pos_t pos;
+        len_t len;
     };
 
     struct Token {
-        Token(TokenKind kind, const std::string & val, const Span & span) : kind(kind), val(val), span(span) {}
-
-        const TokenKind kind;
-        const std::string val;
-        const Span span;
+        Token(TokenKind kind, std::string_view val, const Span & span) : kind(kind), val(val), span(span) {}
+
+        TokenKind kind;
+        /// Slice of the lexer-owned source (or of a materialized value for escaped strings),
+        /// thus only valid as long as the `Lexer` is alive
+        std::string_view val;
+        Span span;
+
+        /// Static name of a value-less token kind, allocation-free;
+        /// empty for the kinds embedding `val`
+        static constexpr std::string_view staticName(TokenKind kind) {
+            // Note: Must be listed in the `TokenKind` order
+            constexpr std::string_view names[] = {
+                "[EOF]",
+                "`,`",
+                "`:`",
+                "`{`",
+                "`}`",
+                "`[`",
+                "`]`",
+                "`null`",
+                "`false`",
+                "`true`",
+                "`nan`",
+                "`+nan`",
+                "`-nan`",
+                "`inf`",
+                "`+inf`",
+                "`-inf`",
+                "", // BinInt
+                "", // HexInt
+                "", // OctoInt
+                "", // DecInt
+                "", // Float
+                "", // String
+                "", // Ref
+            };
+            return names[static_cast<size_t>(kind)];
+        }
 
         std::string toString() const {
             switch (kind) {
-                case TokenKind::Eof: {
-                    return "[EOF]";
-                }
-                case TokenKind::NL: {
-                    return "new line";
-                }
-                case TokenKind::Comma: {
-                    return "`,`";
-                }
-                case TokenKind::Colon: {
-                    return "`:`";
-                }
-                case TokenKind::LBrace: {
-                    return "`{`";
-                }
-                case TokenKind::RBrace: {
-                    return "`}`";
-                }
-                case TokenKind::LBracket: {
-                    return "`[`";
-                }
-                case TokenKind::RBracket: {
-                    return "`]`";
-                }
-                case TokenKind::Null: {
-                    return "`null`";
-                }
-                case TokenKind::False: {
-                    return "`false`";
-                }
-                case TokenKind::True: {
-                    return "`true`";
-                }
-                case TokenKind::NaN: {
-                    return "`nan`";
-                }
-                case TokenKind::PosNaN: {
-                    return "`+nan`";
-                }
-                case TokenKind::NegNaN: {
-                    return "`-nan`";
-                }
-                case TokenKind::Inf: {
-                    return "`inf`";
-                }
-                case TokenKind::PosInf: {
-                    return "`+inf`";
-                }
-                case TokenKind::NegInf: {
-                    return "`-inf`";
-                }
                 case TokenKind::String: {
-                    return "string '" + escstr(val) + "'";
+                    return "string '" + escstr(std::string {val}) + "'";
                 }
                 case TokenKind::BinInt: {
-                    return "number `0b" + val + "`";
+                    return mstr("number `0b", val, "`");
                 }
                 case TokenKind::OctoInt: {
-                    return "number `0o" + val + "`";
+                    return mstr("number `0o", val, "`");
                 }
                 case TokenKind::HexInt: {
-                    return "number `0x" + val + "`";
-                }
-                case TokenKind::DecInt: {
-                    return "number `" + val + "`";
+                    return mstr("number `0x", val, "`");
                 }
+                case TokenKind::DecInt:
                 case TokenKind::Float: {
-                    return "number `" + val + "`";
+                    return mstr("number `", val, "`");
                 }
                 case TokenKind::Ref: {
-                    return "ref `" + val + "`";
+                    return mstr("ref `", val, "`");
+                }
+                default: {
+                    return std::string {staticName(kind)};
                 }
             }
         }
@@ -169,6 +163,38 @@ namespace jacylang {
         }
     };
 
+    // Trivial copyability lets `std::vector` relocate tokens with `memcpy` on growth
+    static_assert(std::is_trivially_copyable_v<Token>);
+
+    /// Bitmap over a set of ASCII bytes: membership is one shift + test instead of
+    /// the OR chain a variadic `isCharAnyOf` expands to
+    struct ByteSet {
+        constexpr ByteSet(std::string_view chars) : lo(0), hi(0) {
+            for (const char c : chars) {
+                const auto b = static_cast<uint8_t>(c);
+                if (b < 64) {
+                    lo |= uint64_t {1} << b;
+                } else {
+                    hi |= uint64_t {1} << (b - 64);
+                }
+            }
+        }
+
+        constexpr bool has(char c) const {
+            const auto b = static_cast<uint8_t>(c);
+            return b < 64 ? (lo >> b) & 1 : b < 128 ? (hi >> (b - 64)) & 1 : false;
+        }
+
+        uint64_t lo;
+        uint64_t hi;
+    };
+
+    /// Bytes terminating an identifier
+    inline constexpr ByteSet stopBytes {",:{}[]'\"\n"};
+    /// Bytes that may follow a keyword (identifier terminators plus space)
+    inline constexpr ByteSet nonContinueBytes {",:{}[]'\" \n"};
+    inline constexpr ByteSet hiddenBytes {" \t\r"};
+
     class Lexer {
     public:
         Lexer() = default;
@@ -176,10 +202,17 @@ namespace jacylang {
 
         TokenStream lex(const std::string & source) {
             this->source = source;
+            sourceSize = source.size();
+            // Trailing sentinel: `peek`/`lookup` read unchecked, and no lex path accepts
+            // NUL, thus every scan stops before running off the real content
+            this->source.append(8, '\0');
             index = 0;
-            lastNl = 0;
-            col = 0;
             tokens.clear();
+            lineStarts.clear();
+            // One token per ~6 bytes is a lower bound for JON-ish content, so a single
+            // up-front allocation covers the whole stream for typical documents
+            tokens.reserve(source.size() / 6);
+            ownedBuf.clear();
 
             while (not eof()) {
                 tokenPos = index;
@@ -192,29 +225,30 @@ namespace jacylang {
             return std::move(tokens);
         }
 
+        /// Offsets right past each token-separating newline; newlines inside strings
+        /// and comments belong to their token and are deliberately not recorded
+        const std::vector<uint32_t> & getLineStarts() const {
+            return lineStarts;
+        }
+
     private:
         std::string source;
+        /// Length of the real content, excluding the sentinel padding
+        size_t sourceSize{0};
 
         size_t index{0};
-        size_t lastNl{0};
-        uint16_t col{0};
         Span::pos_t tokenPos;
+        std::vector<uint32_t> lineStarts;
 
         char peek() {
-            return source.at(index);
+            return source[index];
         }
 
+        // Note: No line/column bookkeeping here -- it is only consumed by `error`,
+        //  which reconstructs both from the error position, keeping advancing a plain increment
         char advance(uint8_t dist = 1) {
             auto cur = peek();
-            for (uint8_t i = 0; i < dist; i++) {
-                if (isNL()) {
-                    lastNl = index;
-                    col = 0;
-                } else {
-                    col++;
-                }
-                index++;
-            }
+            index += dist;
             if (eof()) {
                 return '\0';
             }
@@ -222,11 +256,12 @@ namespace jacylang {
         }
 
         char lookup(uint8_t dist = 1) {
-            return index < source.size() - dist ? source.at(index + dist) : '\0';
+            // In-bounds by the sentinel padding for every lookahead distance in use
+            return source[index + dist];
         }
 
         bool eof() {
-            return index >= source.size();
+            return index >= sourceSize;
         }
 
         bool isNL() {
@@ -250,7 +285,7 @@ namespace jacylang {
         }
 
         bool isNextNonContinue(uint8_t offset) {
-            return eof() or isCharAnyOf(lookup(offset), ',', ':', '{', '}', '[', ']', '\'', '"', ' ', '\n');
+            return eof() or nonContinueBytes.has(lookup(offset));
         }
 
         template<class ...Args>
@@ -259,7 +294,7 @@ namespace jacylang {
         }
 
         bool isHidden() {
-            return isAnyOf(' ', '\t', '\r');
+            return hiddenBytes.has(peek());
         }
 
         bool isDigit() {
@@ -275,9 +310,9 @@ namespace jacylang {
         }
 
         bool isHexDigit(char c) {
-            return isDigit()
-                or c >= 'a' and c <= 'f'
-                or c >= 'A' and c <= 'F';
+            return isDigit(c)
+                or (c >= 'a' and c <= 'f')
+                or (c >= 'A' and c <= 'F');
         }
 
         bool isOctDigit() {
@@ -288,6 +323,122 @@ namespace jacylang {
             return c >= '0' and c <= '7';
         }
 
+        /// "Interesting" bytes are the ones the lexer must look at one-by-one: punctuation,
+        /// quotes, escapes, newlines, comment starts and NUL. Everything else is plain
+        /// identifier/string content and may be skipped in bulk.
+        static bool isInterestingByte(uint8_t c) {
+            switch (c) {
+                case '\0':
+                case '\n':
+                case '"':
+                case '\'':
+                case ',':
+                case '/':
+                case ':':
+                case '[':
+                case '\\':
+                case ']':
+                case '{':
+                case '}': {
+                    return true;
+                }
+                default: {
+                    return false;
+                }
+            }
+        }
+
+        /// Returns the index of the first interesting byte at or after `from`, classifying
+        /// 16 bytes at once where SIMD is available. Bytes with the high bit set (UTF-8
+        /// continuations) are never interesting, so the vector paths may treat them as content.
+        size_t scanUntilInteresting(size_t from) const {
+            const auto * data = reinterpret_cast<const uint8_t *>(source.data());
+            const size_t size = source.size();
+            size_t i = from;
+        #if defined(__SSSE3__)
+            // Nibble classifier: a byte is interesting iff loTable[lo4] and hiTable[hi4]
+            // share a bit. Groups (bits) per high nibble: 0x01 = \0 \n, 0x02 = " ' , /,
+            // 0x04 = :, 0x08 = [ \ ], 0x10 = { }
+            const __m128i loTable = _mm_setr_epi8(
+                0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x02,
+                0x00, 0x00, 0x05, 0x18, 0x0a, 0x18, 0x00, 0x02
+            );
+            const __m128i hiTable = _mm_setr_epi8(
+                0x01, 0x00, 0x02, 0x04, 0x00, 0x08, 0x00, 0x10,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+            );
+            const __m128i low4 = _mm_set1_epi8(0x0f);
+            while (i + 16 <= size) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                const __m128i lo = _mm_and_si128(v, low4);
+                const __m128i hi = _mm_and_si128(_mm_srli_epi16(v, 4), low4);
+                const __m128i t = _mm_and_si128(_mm_shuffle_epi8(loTable, lo), _mm_shuffle_epi8(hiTable, hi));
+                const int mask = _mm_movemask_epi8(_mm_cmpeq_epi8(t, _mm_setzero_si128())) ^ 0xffff;
+                if (mask != 0) {
+                    return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+                }
+                i += 16;
+            }
+        #elif defined(__aarch64__) and defined(__ARM_NEON)
+            const uint8x16_t loTable = {
+                0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x02,
+                0x00, 0x00, 0x05, 0x18, 0x0a, 0x18, 0x00, 0x02
+            };
+            const uint8x16_t hiTable = {
+                0x01, 0x00, 0x02, 0x04, 0x00, 0x08, 0x00, 0x10,
+                0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
+            };
+            while (i + 16 <= size) {
+                const uint8x16_t v = vld1q_u8(data + i);
+                const uint8x16_t lo = vandq_u8(v, vdupq_n_u8(0x0f));
+                const uint8x16_t hi = vshrq_n_u8(v, 4);
+                const uint8x16_t t = vandq_u8(vqtbl1q_u8(loTable, lo), vqtbl1q_u8(hiTable, hi));
+                if (vmaxvq_u8(t) != 0) {
+                    // Narrow the per-byte comparison to a 64-bit mask, 4 bits per lane
+                    const uint8x16_t cmp = vcgtq_u8(t, vdupq_n_u8(0));
+                    const uint64_t mask = vget_lane_u64(
+                        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4)), 0
+                    );
+                    return i + (static_cast<size_t>(__builtin_ctzll(mask)) >> 2);
+                }
+                i += 16;
+            }
+        #endif
+            while (i < size and not isInterestingByte(data[i])) {
+                i++;
+            }
+            return i;
+        }
+
+        /// Skips uninteresting bytes in bulk
+        void skipUninteresting() {
+            index = scanUntilInteresting(index);
+        }
+
+        /// Returns the index of the next byte the string loop must inspect: the quote,
+        /// `\` or, for single-line strings, the terminating `\n`. Everything in between
+        /// is content and skipped at `memchr` speed
+        size_t scanStringRun(size_t from, char quote, bool multiLine) const {
+            const char * base = source.data();
+            const char * p = base + from;
+            const char * end = base + source.size();
+            const auto * stop = static_cast<const char *>(memchr(p, quote, static_cast<size_t>(end - p)));
+            if (stop == nullptr) {
+                stop = end;
+            }
+            const auto * esc = static_cast<const char *>(memchr(p, '\\', static_cast<size_t>(stop - p)));
+            if (esc != nullptr) {
+                stop = esc;
+            }
+            if (not multiLine) {
+                const auto * nl = static_cast<const char *>(memchr(p, '\n', static_cast<size_t>(stop - p)));
+                if (nl != nullptr) {
+                    stop = nl;
+                }
+            }
+            return static_cast<size_t>(stop - base);
+        }
+
         void skip(char c) {
             if (peek() != c) {
                 expectedError("`" + mstr(c) + "`");
@@ -303,74 +454,170 @@ namespace jacylang {
             return false;
         }
 
-        void lexCurrent() {
-            switch (peek()) {
-                case '/': {
-                    return lexComment();
-                }
-                case '\'':
-                case '"': {
-                    return lexString();
-                }
-                case ',': {
-                    addTokenAdvance(TokenKind::Comma, 1);
-                    break;
-                }
-                case ':': {
-                    addTokenAdvance(TokenKind::Colon, 1);
-                    break;
-                }
-                case '{': {
-                    addTokenAdvance(TokenKind::LBrace, 1);
-                    break;
-                }
-                case '}': {
-                    addTokenAdvance(TokenKind::RBrace, 1);
-                    break;
-                }
-                case '[': {
-                    addTokenAdvance(TokenKind::LBracket, 1);
-                    break;
-                }
-                case ']': {
-                    addTokenAdvance(TokenKind::RBracket, 1);
-                    break;
+        void lexComma() {
+            addTokenAdvance(TokenKind::Comma, 1);
+        }
+
+        void lexColon() {
+            addTokenAdvance(TokenKind::Colon, 1);
+        }
+
+        void lexLBrace() {
+            addTokenAdvance(TokenKind::LBrace, 1);
+        }
+
+        void lexRBrace() {
+            addTokenAdvance(TokenKind::RBrace, 1);
+        }
+
+        void lexLBracket() {
+            addTokenAdvance(TokenKind::LBracket, 1);
+        }
+
+        void lexRBracket() {
+            addTokenAdvance(TokenKind::RBracket, 1);
+        }
+
+        void lexNL() {
+            // Newlines make no tokens: in JSON-like data they can outnumber the real
+            // tokens severalfold; the parser instead asks "was there a newline between
+            // two tokens?" against `lineStarts`
+            advance();
+            lineStarts.push_back(static_cast<uint32_t>(index));
+        }
+
+        void lexHidden() {
+            // The current byte is known hidden; swallow the whole run in one scan
+            // instead of re-entering the dispatch loop per byte
+            index = scanWhileHidden(index + 1);
+        }
+
+        /// Returns the index of the first non-hidden byte at or after `from`,
+        /// comparing 16 bytes at once where SIMD is available.
+        /// Note: `\n` is not hidden -- it makes a token
+        size_t scanWhileHidden(size_t from) const {
+            const auto * data = reinterpret_cast<const uint8_t *>(source.data());
+            const size_t size = source.size();
+            size_t i = from;
+        #if defined(__SSE2__)
+            const __m128i sp = _mm_set1_epi8(' ');
+            const __m128i tab = _mm_set1_epi8('\t');
+            const __m128i cr = _mm_set1_epi8('\r');
+            while (i + 16 <= size) {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+                const __m128i hidden = _mm_or_si128(
+                    _mm_or_si128(_mm_cmpeq_epi8(v, sp), _mm_cmpeq_epi8(v, tab)), _mm_cmpeq_epi8(v, cr)
+                );
+                const int mask = _mm_movemask_epi8(hidden) ^ 0xffff;
+                if (mask != 0) {
+                    return i + static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
                 }
-                default: {
-                    return lexMisc();
+                i += 16;
+            }
+        #elif defined(__aarch64__) and defined(__ARM_NEON)
+            while (i + 16 <= size) {
+                const uint8x16_t v = vld1q_u8(data + i);
+                const uint8x16_t hidden = vorrq_u8(
+                    vorrq_u8(vceqq_u8(v, vdupq_n_u8(' ')), vceqq_u8(v, vdupq_n_u8('\t'))),
+                    vceqq_u8(v, vdupq_n_u8('\r'))
+                );
+                if (vminvq_u8(hidden) != 0xff) {
+                    const uint64_t mask = ~vget_lane_u64(
+                        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(hidden), 4)), 0
+                    );
+                    return i + (static_cast<size_t>(__builtin_ctzll(mask)) >> 2);
                 }
+                i += 16;
+            }
+        #endif
+            while (i < size and hiddenBytes.has(static_cast<char>(data[i]))) {
+                i++;
+            }
+            return i;
+        }
+
+        void lexSign() {
+            // `-`/`+` starts a number only when followed by a digit,
+            // otherwise it is identifier content (`-inf`, `+nan`, ...)
+            if (isDigit(lookup())) {
+                return lexNum();
             }
+            lexMisc();
+        }
+
+        using Handler = void (Lexer::*)();
+
+        /// Per-byte handler table acting as the lexer's transition function: every leading
+        /// byte maps straight to its state in a single indirect load, with no second
+        /// branch ladder behind it; the rest falls through to the identifier state
+        static constexpr std::array<Handler, 256> makeHandlers() {
+            std::array<Handler, 256> handlers {};
+            for (auto & handler : handlers) {
+                handler = &Lexer::lexMisc;
+            }
+            handlers['/'] = &Lexer::lexComment;
+            handlers['\''] = &Lexer::lexString;
+            handlers['"'] = &Lexer::lexString;
+            handlers[','] = &Lexer::lexComma;
+            handlers[':'] = &Lexer::lexColon;
+            handlers['{'] = &Lexer::lexLBrace;
+            handlers['}'] = &Lexer::lexRBrace;
+            handlers['['] = &Lexer::lexLBracket;
+            handlers[']'] = &Lexer::lexRBracket;
+            handlers['\n'] = &Lexer::lexNL;
+            handlers[' '] = &Lexer::lexHidden;
+            handlers['\t'] = &Lexer::lexHidden;
+            handlers['\r'] = &Lexer::lexHidden;
+            for (uint8_t c = '0'; c <= '9'; c++) {
+                handlers[c] = &Lexer::lexNum;
+            }
+            handlers['-'] = &Lexer::lexSign;
+            handlers['+'] = &Lexer::lexSign;
+            return handlers;
+        }
+
+        void lexCurrent() {
+            static constexpr std::array<Handler, 256> handlers = makeHandlers();
+            (this->*handlers[static_cast<uint8_t>(peek())])();
         }
 
         void lexComment() {
             if (peek() != '/') {
                 throw std::logic_error("Called `Lexer::lexComment` with not the '/' char");
             }
+            const char * base = source.data();
+            const char * end = base + source.size();
             if (lookup() == '*') {
                 advance(2);
 
-                // Parse block comment handling nested
+                // Parse block comment handling nested: `memchr` jumps between `*` anchors,
+                // so the bytes in between are skipped at vectorized `memchr` speed
                 uint8_t depth{1};
-                while (not eof()) {
-                    if (peek() == '/' and lookup() == '*') {
-                        depth++;
+                const char * p = base + index;
+                while (p < end and depth > 0) {
+                    const auto * q = static_cast<const char *>(memchr(p, '*', static_cast<size_t>(end - p)));
+                    if (q == nullptr) {
+                        p = end;
+                        break;
                     }
-
-                    if (peek() == '*' and lookup() == '/') {
+                    if (q - 1 >= p and q[-1] == '/') {
+                        // `/*` -- the `/` must not be consumed yet, e.g. not the one closing `*/`
+                        depth++;
+                        p = q + 1;
+                    } else if (q + 1 < end and q[1] == '/') {
                         depth--;
-                    }
-
-                    if (depth == 0) {
-                        break;
+                        p = q + 2;
+                    } else {
+                        p = q + 1;
                     }
                 }
+                index = static_cast<size_t>(p - base);
             } else if (lookup() == '/') {
-                while (not eof()) {
-                    advance();
-                    if (isNL()) {
-                        break;
-                    }
-                }
+                // Line comment runs to the next `\n` (left for the newline token)
+                const auto * nl = static_cast<const char *>(memchr(base + index, '\n', source.size() - index));
+                index = nl != nullptr ? static_cast<size_t>(nl - base) : source.size();
+            } else {
+                unexpectedToken();
             }
         }
 
@@ -387,62 +634,77 @@ namespace jacylang {
             }
 
             bool closed = false;
-            std::string val;
+            // The value stays a plain slice of `source`; escape processing is the only thing
+            // forcing materialization into the arena
+            bool escaped = false;
+            const size_t bufStart = ownedBuf.size();
+            const size_t start = index;
+            size_t runStart = index;
             while (not eof()) {
+                index = scanStringRun(index, quote, multiLine);
+                if (eof()) {
+                    break;
+                }
+
                 if (is('\\')) {
+                    if (not escaped) {
+                        escaped = true;
+                        ensureOwnedCapacity();
+                    }
+                    ownedBuf.append(source, runStart, index - runStart);
                     advance();
                     switch (peek()) {
                         case '\'':
                         case '\\':
                         case '"': {
-                            val += advance();
+                            ownedBuf += advance();
                             break;
                         }
                         case 'n': {
-                            val += '\n';
+                            ownedBuf += '\n';
                             advance();
                             break;
                         }
                         case 'r': {
-                            val += '\r';
+                            ownedBuf += '\r';
                             advance();
                             break;
                         }
                         case 't': {
-                            val += '\t';
+                            ownedBuf += '\t';
                             advance();
                             break;
                         }
                         case 'b': {
-                            val += '\b';
+                            ownedBuf += '\b';
                             advance();
                             break;
                         }
                         case 'f': {
-                            val += '\f';
+                            ownedBuf += '\f';
                             advance();
                             break;
                         }
                         case 'v': {
-                            val += '\v';
+                            ownedBuf += '\v';
                             advance();
                             break;
                         }
                         default: {
                             if (isOctDigit() and isOctDigit(lookup()) and isOctDigit(lookup(2))) {
                                 // Octal representation of ASCII character
-                                val += static_cast<char>(
+                                ownedBuf += static_cast<char>(
                                     (advance() - '0') * 64 + (advance() - '0') * 8 + (advance() - '0')
                                 );
                             } else if (is('x') and isHexDigit(lookup()) and isHexDigit(lookup(2))) {
                                 // Hex representation of ASCII character
                                 advance(); // Skip `x`
-                                val += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
+                                ownedBuf += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
                             } else if (is('u') and isHexDigit(lookup()) and isHexDigit(lookup(2))) {
                                 advance(); // Skip `u`
                                 // Hex representation of unicode point below 10000
-                                val += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
-                                val += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
+                                ownedBuf += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
+                                ownedBuf += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
                             } else if (
                                 is('U')
                                 and isHexDigit(lookup())
@@ -452,26 +714,37 @@ namespace jacylang {
                             ) {
                                 advance(); // Skip `U`
                                 // Hex representation of unicode point
-                                val += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
-                                val += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
-                                val += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
-                                val += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
+                                ownedBuf += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
+                                ownedBuf += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
+                                ownedBuf += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
+                                ownedBuf += static_cast<char>(hexChar2Int(advance()) * 16 + hexChar2Int(advance()));
                             } else {
-                                val += peek();
+                                ownedBuf += advance();
                             }
                         }
                     }
+                    runStart = index;
+                    continue;
                 }
 
-                if (multiLine and isSeq(quote, quote, quote)) {
-                    closed = true;
-                    break;
-                } else if (isNL() or is(quote)) {
+                if (multiLine) {
+                    if (isSeq(quote, quote, quote)) {
+                        closed = true;
+                        break;
+                    }
+                    // A lone quote (or the newline a single-line scan would stop at)
+                    // is plain multi-line content
+                    advance();
+                    continue;
+                }
+
+                if (is(quote)) {
                     closed = true;
                     break;
                 }
 
-                val += advance();
+                // Newline before the closing quote: reported as unterminated below
+                break;
             }
 
             if (!closed) {
@@ -482,138 +755,171 @@ namespace jacylang {
                 }
             }
 
+            const size_t len = index - start;
+            if (escaped) {
+                ownedBuf.append(source, runStart, index - runStart);
+            }
+
             advance(multiLine ? 3 : 1);
 
-            addToken(TokenKind::String, val);
+            if (escaped) {
+                addOwnedToken(TokenKind::String, bufStart);
+            } else {
+                addToken(TokenKind::String, start, len);
+            }
         }
 
         void lexNum() {
-            TokenKind kind;
-            std::string val;
-
-            bool baseSpecific = false;
-
             bool sign = false;
+            // The number is a slice of `source` too: `-` stays inside the slice, `+` and base
+            // prefixes do not; `_` separators force materialization with separators stripped
+            size_t numStart = index;
+            bool hasSep = false;
             if (is('+')) {
                 advance();
+                numStart = index;
             } else if (is('-')) {
-                val += '-';
                 advance();
                 sign = true;
             }
 
-            // Binary //
-            if (peek() == '0' and (lookup() == 'b' or lookup() == 'B')) {
-                if (sign) {
-                    error("Signed binary numbers are not allowed");
-                }
+            // Base-specific prefixes: a single dispatch on the lowercased char after `0`,
+            // each base emits and returns on its own instead of re-checking flags below
+            if (is('0')) {
+                switch (lookup() | 0x20) {
+                    case 'b': {
+                        if (sign) {
+                            error("Signed binary numbers are not allowed");
+                        }
 
-                baseSpecific = true;
+                        advance(2);
+                        numStart = index;
+                        if (not isAnyOf('0', '1')) {
+                            expectedError("binary digit");
+                        }
+                        while (not eof()) {
+                            hasSep |= skipOpt('_');
+                            if (not isAnyOf('0', '1')) {
+                                break;
+                            }
+                            advance();
+                        }
 
-                advance(2);
-                if (not isAnyOf('0', '1')) {
-                    expectedError("binary digit");
-                }
-                while (not eof()) {
-                    skipOpt('_');
-                    if (not isAnyOf('0', '1')) {
-                        break;
+                        return addNumToken(TokenKind::BinInt, numStart, hasSep);
                     }
-                    val += advance();
-                }
+                    case 'x': {
+                        if (sign) {
+                            error("Signed hexadecimal numbers are not allowed");
+                        }
 
-                kind = TokenKind::OctoInt;
-            }
+                        advance(2);
+                        numStart = index;
+                        if (not isHexDigit()) {
+                            expectedError("hexadecimal digit");
+                        }
+                        while (not eof()) {
+                            hasSep |= skipOpt('_');
+                            if (not isHexDigit()) {
+                                break;
+                            }
+                            advance();
+                        }
 
-            // Hexadecimal //
-            if (peek() == '0' and (lookup() == 'x' or lookup() == 'X')) {
-                if (sign) {
-                    error("Signed hexadecimal numbers are not allowed");
-                }
+                        return addNumToken(TokenKind::HexInt, numStart, hasSep);
+                    }
+                    case 'o': {
+                        if (sign) {
+                            error("Signed octal numbers are not allowed");
+                        }
 
-                baseSpecific = true;
+                        advance(2);
+                        numStart = index;
+                        if (not isOctDigit()) {
+                            expectedError("octal digit");
+                        }
+                        while (not eof()) {
+                            hasSep |= skipOpt('_');
+                            if (not isOctDigit()) {
+                                break;
+                            }
+                            advance();
+                        }
 
-                advance(2);
-                if (not isHexDigit()) {
-                    expectedError("hexadecimal digit");
-                }
-                while (not eof()) {
-                    skipOpt('_');
-                    if (not isHexDigit()) {
+                        return addNumToken(TokenKind::OctoInt, numStart, hasSep);
+                    }
+                    default: {
                         break;
                     }
-                    val += advance();
                 }
-
-                kind = TokenKind::HexInt;
             }
 
-            // Octal //
-            if (peek() == '0' and (lookup() == 'o' or lookup() == 'O')) {
-                if (sign) {
-                    error("Signed octal numbers are not allowed");
-                }
-
-                baseSpecific = true;
-
-                advance(2);
-                if (not isOctDigit()) {
-                    expectedError("octal digit");
-                }
-                while (not eof()) {
-                    skipOpt('_');
-                    if (not isOctDigit()) {
-                        break;
-                    }
-                    val += advance();
+            // Decimal //
+            TokenKind kind = TokenKind::DecInt;
+            while (not eof()) {
+                hasSep |= skipOpt('_');
+                if (not isDigit()) {
+                    break;
                 }
-
-                kind = TokenKind::OctoInt;
+                advance();
             }
 
-            if (not baseSpecific) {
+            if (is('.')) {
+                advance();
+                if (not isDigit()) {
+                    expectedError("fractional part of number");
+                }
                 while (not eof()) {
-                    skipOpt('_');
+                    hasSep |= skipOpt('_');
                     if (not isDigit()) {
                         break;
                     }
-                    val += advance();
+                    advance();
                 }
+                kind = TokenKind::Float;
+            }
 
-                kind = TokenKind::DecInt;
+            addNumToken(kind, numStart, hasSep);
+        }
 
-                if (is('.')) {
-                    val += advance();
-                    if (not isDigit()) {
-                        expectedError("fractional part of number");
+        void addNumToken(TokenKind kind, size_t numStart, bool hasSep) {
+            if (hasSep) {
+                ensureOwnedCapacity();
+                const size_t bufStart = ownedBuf.size();
+                for (size_t i = numStart; i < index; i++) {
+                    if (source[i] != '_') {
+                        ownedBuf += source[i];
                     }
-                    while (not eof()) {
-                        skipOpt('_');
-                        if (not isDigit()) {
-                            break;
-                        }
-                        val += advance();
-                    }
-                    kind = TokenKind::Float;
                 }
+                addOwnedToken(kind, bufStart);
+            } else {
+                addToken(kind, numStart, index - numStart);
             }
-
-            addToken(kind, val);
         }
 
+        /// Identifier/keyword/ref state; newlines, whitespace and numbers are
+        /// dispatched to their own handlers by the byte table
         void lexMisc() {
-            if (isNL()) {
-                addTokenAdvance(TokenKind::NL, 1);
-                return;
-            }
-
-            if (isHidden()) {
-                advance();
-                return;
-            }
-
-            if (isDigit() or (is('-') or is('+')) and isDigit(lookup())) {
-                return lexNum();
+            // Fast path for the common keywords: `memcmp` with a constant length compiles to a
+            // single word-sized compare, replacing the scan-and-trim of the generic identifier
+            // path. `isNextNonContinue` keeps `nullable`-like identifiers on the generic path,
+            // and a keyword cut short by EOF falls through to it as well.
+            if (index + 5 <= sourceSize) {
+                const char * at = source.data() + index;
+                if (memcmp(at, "null", 4) == 0 and isNextNonContinue(4)) {
+                    advance(4);
+                    addToken(TokenKind::Null, 4);
+                    return;
+                }
+                if (memcmp(at, "true", 4) == 0 and isNextNonContinue(4)) {
+                    advance(4);
+                    addToken(TokenKind::True, 4);
+                    return;
+                }
+                if (memcmp(at, "false", 5) == 0 and isNextNonContinue(5)) {
+                    advance(5);
+                    addToken(TokenKind::False, 5);
+                    return;
+                }
             }
 
             bool isRef = false;
@@ -623,17 +929,19 @@ namespace jacylang {
             }
 
             // Identifier is anything not containing specific tokens
-            std::string val;
+            const size_t start = index;
             while (not eof()) {
-                if (isAnyOf(',', ':', '{', '}', '[', ']', '\'', '"') or isNL()) {
+                skipUninteresting();
+                if (eof() or stopBytes.has(peek())) {
                     break;
                 }
-                val += advance();
+                advance();
             }
+            const std::string_view val {source.data() + start, index - start};
 
             if (not isRef) {
                 // Left spaces are already skipped by `isHidden`, thus trim right side of string to check for constant
-                const auto & trimmed = rtrim(val);
+                const auto trimmed = rtrim(val);
                 if (trimmed == "null") {
                     addToken(TokenKind::Null, 4);
                 } else if (trimmed == "false") {
@@ -654,18 +962,36 @@ namespace jacylang {
                     addToken(TokenKind::NegInf, 4);
                 } else {
                     // Add identifier as string
-                    addToken(TokenKind::String, std::move(val));
+                    addToken(TokenKind::String, start, val.size());
                 }
             } else {
-                addToken(TokenKind::Ref, std::move(val));
+                addToken(TokenKind::Ref, start, val.size());
             }
        }
 
         // Tokens //
         TokenStream tokens;
 
-        void addToken(TokenKind kind, const std::string & val) {
-            tokens.emplace_back(kind, val, Span {tokenPos, val.size()});
+        /// Arena for escape-processed and separator-stripped values, which cannot be
+        /// sliced from `source`. Materialization only ever shrinks content, thus reserving
+        /// the source size once guarantees the arena never reallocates and the emitted
+        /// slices stay valid; the reservation is deferred until the first materialization
+        std::string ownedBuf;
+
+        void ensureOwnedCapacity() {
+            if (ownedBuf.capacity() < source.size()) {
+                ownedBuf.reserve(source.size());
+            }
+        }
+
+        void addToken(TokenKind kind, size_t startIdx, size_t len) {
+            tokens.emplace_back(kind, std::string_view {source.data() + startIdx, len}, Span {tokenPos, len});
+        }
+
+        /// Emits a token whose value is the arena content accumulated since `bufStart`
+        void addOwnedToken(TokenKind kind, size_t bufStart) {
+            const std::string_view owned {ownedBuf.data() + bufStart, ownedBuf.size() - bufStart};
+            tokens.emplace_back(kind, owned, Span {tokenPos, owned.size()});
         }
 
         void addToken(TokenKind kind, Span::len_t len) {
@@ -678,13 +1004,20 @@ namespace jacylang {
         }
 
         // Errors //
-        void unexpectedToken() {
+        [[noreturn]] JON_COLD void unexpectedToken() {
+            if (eof()) {
+                error("Unexpected end of input");
+            }
             error(mstr("Unexpected token '", peek(), "'"));
         }
 
-        void expectedError(const std::string & expected) {
+        [[noreturn]] JON_COLD void expectedError(const std::string & expected) {
             std::string got;
-            if (isNL()) {
+            if (eof()) {
+                // Past the end `peek` yields the NUL sentinel -- name the condition
+                // instead of interpolating that byte into the message
+                got = "[EOF]";
+            } else if (isNL()) {
                 got = "new line";
             } else {
                 got = mstr("`", peek(), "`");
@@ -693,17 +1026,25 @@ namespace jacylang {
             error(mstr("Expected ", expected, ", got ", got));
         }
 
-        void error(const std::string & msg) {
-            size_t sliceTo = index;
-            while (not eof()) {
-                sliceTo = index;
-                if (isNL()) {
-                    break;
+        [[noreturn]] JON_COLD void error(const std::string & msg) {
+            // Reconstruct the line and column from the error position: scanning two lines
+            // once on the cold path is cheaper than tracking them on every `advance`
+            const size_t errPos = index;
+            size_t lineStart = 0;
+            size_t col = errPos;
+            if (errPos > 0) {
+                const auto nl = source.rfind('\n', errPos - 1);
+                if (nl != std::string::npos) {
+                    lineStart = nl;
+                    col = errPos - nl - 1;
                 }
-                advance();
+            }
+            auto lineEnd = source.find('\n', errPos);
+            if (lineEnd == std::string::npos) {
+                lineEnd = sourceSize;
             }
 
-            const auto & line = source.substr(lastNl, sliceTo - lastNl);
+            const auto & line = source.substr(lineStart, lineEnd - lineStart);
             std::string pointLine;
             if (msg.size() + 2 < col) {
                 pointLine = std::string(col - msg.size() - 1, ' ') + msg + " ^";
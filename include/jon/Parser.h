@@ -1,6 +1,9 @@
 #ifndef JON_PARSER_H
 #define JON_PARSER_H
 
+#include <algorithm>
+#include <deque>
+
 #include "Lexer.h"
 #include "Printer.h"
 #include "ast.h"
@@ -11,12 +14,10 @@ namespace jacylang {
         Parser() {}
         ~Parser() = default;
 
-        ast::value_ptr parse(const std::string & source, bool debug) {
+        ast::Value parse(const std::string & source, bool debug) {
             index = 0;
-            lastNl = 0;
             this->source = source;
 
-            Lexer lexer;
             tokens = lexer.lex(source);
 
             Printer printer;
@@ -25,7 +26,6 @@ namespace jacylang {
                 printer.printTokens(tokens);
             }
 
-            skipNls(true);
             auto ast = parseValue(true);
 
             if (debug) {
@@ -37,9 +37,14 @@ namespace jacylang {
 
     private:
         std::string source;
+        /// Token values are slices of the lexer-owned source, thus the lexer must live
+        /// as long as the token stream does
+        Lexer lexer;
         TokenStream tokens;
+        /// Keys materialized during parsing (e.g. `$`-prefixed refs) cannot be sliced
+        /// from the source; `std::deque` keeps references stable while entries are added
+        std::deque<std::string> ownedStrings;
         size_t index;
-        size_t lastNl{0};
 
         const Token & peek() const {
             return tokens.at(index);
@@ -78,7 +83,6 @@ namespace jacylang {
                 }
                 case TokenKind::LBrace:
                 case TokenKind::Eof:
-                case TokenKind::NL:
                 case TokenKind::Comma:
                 case TokenKind::Colon:
                 case TokenKind::RBrace:
@@ -99,53 +103,41 @@ namespace jacylang {
             return tokens.at(index + 1).kind == kind;
         }
 
-        Token skip(TokenKind kind, const std::string & expected, bool rightNls) {
+        Token skip(TokenKind kind, const std::string & expected) {
             auto token = peek();
             if (token.kind == kind) {
                 advance();
-
-                if (rightNls) {
-                    skipNls(true);
-                }
-
                 return token;
             }
             expectedError(expected);
         }
 
-        bool skipNls(bool optional) {
-            if (is(TokenKind::NL)) {
-                while (is(TokenKind::NL)) {
-                    lastNl = index;
-                    advance();
-                }
-                return true;
-            } else if (not optional) {
-                expectedError("new line");
-            }
-            return false;
-        }
-
-        bool skipOpt(TokenKind kind, bool rightNls = false) {
+        bool skipOpt(TokenKind kind) {
             if (peek().kind == kind) {
                 advance();
-
-                if (rightNls) {
-                    skipNls(true);
-                }
-
                 return true;
             }
 
             return false;
         }
 
-        bool skipOptSep() {
-            // Skip first new lines (optionally)
-            bool nl = skipNls(true);
+        /// Was there a newline between the previously consumed token and the current one?
+        /// Newlines make no tokens, thus this checks the lexer's line table for an entry
+        /// falling into the gap between the two spans -- O(log lines), but needed only
+        /// when entries are separated
+        bool nlBefore() const {
+            if (index == 0) {
+                return false;
+            }
+            const auto & prev = tokens[index - 1];
+            const auto & starts = lexer.getLineStarts();
+            const auto next = std::upper_bound(starts.begin(), starts.end(), prev.span.pos + prev.span.len);
+            return next != starts.end() and *next <= peek().span.pos;
+        }
 
-            // Skip comma, even if it goes after new lines, skipping next new lines optionally
-            bool comma = skipOpt(TokenKind::Comma, true);
+        bool skipOptSep() {
+            bool nl = nlBefore();
+            bool comma = skipOpt(TokenKind::Comma);
 
             return nl or comma;
         }
@@ -159,9 +151,7 @@ namespace jacylang {
         ast::Ident parseKey() {
             switch (peek().kind) {
                 case TokenKind::String: {
-                    return ast::Ident {
-                        skip(TokenKind::String, "[jon bug] key", true).val
-                    };
+                    return ast::Ident {skip(TokenKind::String, "[jon bug] key").val};
                 }
                 case TokenKind::Null: {
                     advance();
@@ -207,10 +197,9 @@ namespace jacylang {
                     return ast::Ident {advance().val};
                 }
                 case TokenKind::Ref: {
-                    return ast::Ident {"$" + advance().val};
+                    return ast::Ident {ownedStrings.emplace_back("$" + std::string {advance().val})};
                 }
                 case TokenKind::Eof:
-                case TokenKind::NL:
                 case TokenKind::Comma:
                 case TokenKind::Colon:
                 case TokenKind::LBrace:
@@ -225,7 +214,67 @@ namespace jacylang {
             }
         }
 
-        ast::value_ptr parseValue(bool root = false) {
+        // Number parsing //
+        // The lexer already validated the digits, stripped `_` separators and base prefixes
+        // and tagged the token with its base, thus `std::stoul`'s locale handling, base
+        // detection and `std::string` round-trip are pure overhead here
+
+        /// Parses digits of a power-of-two base (`shift` = log2(base)) by shift-and-or
+        static uint64_t parsePow2Int(std::string_view digits, uint8_t shift) {
+            uint64_t val{0};
+            for (const char c : digits) {
+                if (val >> (64 - shift) != 0) {
+                    throw std::out_of_range("jon integer literal");
+                }
+                val = (val << shift) | hexChar2Int(c);
+            }
+            return val;
+        }
+
+        /// Parses a run of 8 decimal digits at once: SWAR reduction of the byte chunk,
+        /// little-endian layout is presumed by the constants
+        static uint32_t parse8DecDigits(const char * at) {
+            uint64_t chunk;
+            memcpy(&chunk, at, 8);
+            chunk -= 0x3030303030303030;
+            chunk = chunk * 10 + (chunk >> 8);
+            chunk = ((chunk & 0x000000FF000000FF) * 0x000F424000000064
+                + ((chunk >> 16) & 0x000000FF000000FF) * 0x0000271000000001) >> 32;
+            return static_cast<uint32_t>(chunk);
+        }
+
+        static int64_t parseDecInt(std::string_view digits) {
+            bool neg = false;
+            if (not digits.empty() and digits.front() == '-') {
+                neg = true;
+                digits.remove_prefix(1);
+            }
+
+            uint64_t val{0};
+            const char * at = digits.data();
+            size_t left = digits.size();
+        #if defined(__BYTE_ORDER__) and __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            while (left >= 8) {
+                if (__builtin_mul_overflow(val, 100'000'000ull, &val)
+                    or __builtin_add_overflow(val, parse8DecDigits(at), &val)) {
+                    throw std::out_of_range("jon integer literal");
+                }
+                at += 8;
+                left -= 8;
+            }
+        #endif
+            for (; left > 0; at++, left--) {
+                if (__builtin_mul_overflow(val, 10ull, &val)
+                    or __builtin_add_overflow(val, static_cast<uint64_t>(*at - '0'), &val)) {
+                    throw std::out_of_range("jon integer literal");
+                }
+            }
+            // Negate in unsigned arithmetic: `-INT64_MIN` does not exist, thus casting
+            // `-9223372036854775808`'s digits first and negating after would be UB
+            return neg ? static_cast<int64_t>(0 - val) : static_cast<int64_t>(val);
+        }
+
+        ast::Value parseValue(bool root = false) {
             if (root and isKey() and lookupIs(TokenKind::Colon)) {
                 return parseObject(true);
             }
@@ -239,45 +288,45 @@ namespace jacylang {
                 }
                 case TokenKind::Null: {
                     advance();
-                    return std::make_unique<ast::Null>();
+                    return ast::Value {ast::Null {}};
                 }
                 case TokenKind::True:
                 case TokenKind::False: {
-                    return std::make_unique<ast::Bool>(advance().kind == TokenKind::True);
+                    return ast::Value {ast::Bool {advance().kind == TokenKind::True}};
                 }
                 case TokenKind::NaN:
                 case TokenKind::PosNaN:
                 case TokenKind::NegNaN: {
                     advance();
-                    return std::make_unique<ast::Float>(std::numeric_limits<double>::quiet_NaN());
+                    return ast::Value {ast::Float {std::numeric_limits<double>::quiet_NaN()}};
                 }
                 case TokenKind::Inf:
                 case TokenKind::NegInf:
                 case TokenKind::PosInf: {
-                    return std::make_unique<ast::Float>(
+                    return ast::Value {ast::Float {
                         std::numeric_limits<double>::infinity() * (advance().kind == TokenKind::NegInf ? -1 : 1)
-                    );
+                    }};
                 }
                 case TokenKind::BinInt: {
-                    return std::make_unique<ast::Int>(std::stoul(advance().val, nullptr, 2));
+                    return ast::Value {ast::Int {static_cast<int64_t>(parsePow2Int(advance().val, 1))}};
                 }
                 case TokenKind::OctoInt: {
-                    return std::make_unique<ast::Int>(std::stoul(advance().val, nullptr, 8));
+                    return ast::Value {ast::Int {static_cast<int64_t>(parsePow2Int(advance().val, 3))}};
                 }
                 case TokenKind::HexInt: {
-                    return std::make_unique<ast::Int>(std::stoul(advance().val, nullptr, 16));
+                    return ast::Value {ast::Int {static_cast<int64_t>(parsePow2Int(advance().val, 4))}};
                 }
                 case TokenKind::DecInt: {
-                    return std::make_unique<ast::Int>(std::stoul(advance().val));
+                    return ast::Value {ast::Int {parseDecInt(advance().val)}};
                 }
                 case TokenKind::Float: {
-                    return std::make_unique<ast::Float>(std::stod(advance().val));
+                    return ast::Value {ast::Float {std::stod(std::string {advance().val})}};
                 }
                 case TokenKind::String: {
-                    return std::make_unique<ast::String>(advance().val);
+                    return ast::Value {ast::String {advance().val}};
                 }
                 case TokenKind::Ref: {
-                    return std::make_unique<ast::Ref>(ast::Ident {advance().val});
+                    return ast::Value {ast::Ref {ast::Ident {advance().val}}};
                 }
                 default: {
                     expectedError("value");
@@ -285,13 +334,12 @@ namespace jacylang {
             }
         }
 
-        ast::value_ptr parseObject(bool root = false) {
+        ast::Value parseObject(bool root = false) {
             bool rootBraced = false;
             if (not root) {
-                skip(TokenKind::LBrace, "[BUG] expected `{`", true); // Skip `{`
+                skip(TokenKind::LBrace, "[BUG] expected `{`"); // Skip `{`
             } else {
-                skipNls(true);
-                rootBraced = skipOpt(TokenKind::LBrace, true);
+                rootBraced = skipOpt(TokenKind::LBrace);
             }
 
             bool first = true;
@@ -312,22 +360,21 @@ namespace jacylang {
                 }
 
                 auto key = parseKey();
-                skipNls(true);
-                skip(TokenKind::Colon, "`:` delimiter", true);
+                skip(TokenKind::Colon, "`:` delimiter");
                 auto val = parseValue();
 
                 entries.emplace_back(ast::KeyValue{std::move(key), std::move(val)});
             }
 
             if (not root or rootBraced) {
-                skip(TokenKind::RBrace, "closing `}`", false);
+                skip(TokenKind::RBrace, "closing `}`");
             }
 
-            return std::make_unique<ast::Object>(std::move(entries));
+            return ast::Value {ast::Object {std::move(entries)}};
         }
 
-        ast::value_ptr parseArray() {
-            skip(TokenKind::LBracket, "[BUG] expected `[`", true);
+        ast::Value parseArray() {
+            skip(TokenKind::LBracket, "[BUG] expected `[`");
 
             bool first = true;
             ast::value_list values;
@@ -351,31 +398,27 @@ namespace jacylang {
 
             skipOptSep(); // Trailing separator
 
-            skip(TokenKind::RBracket, "Closing `]`", false);
+            skip(TokenKind::RBracket, "Closing `]`");
 
-            return std::make_unique<ast::Array>(std::move(values));
+            return ast::Value {ast::Array {std::move(values)}};
         }
 
         // Errors //
-        void expectedError(const std::string & expected) {
+        [[noreturn]] JON_COLD void expectedError(const std::string & expected) {
             // TODO: Token to string
             error(mstr("Expected ", expected, ", got ", peek().toString()));
         }
 
-        void error(const std::string & msg) {
-            size_t errorIndex = index;
-            size_t sliceTo = index;
-            while (not eof()) {
-                if (is(TokenKind::NL)) {
-                    sliceTo = index;
-                    break;
-                }
-                advance();
-            }
+        [[noreturn]] JON_COLD void error(const std::string & msg) {
+            // Slice the line enclosing the error token out of the lexer's line table
+            const auto errPos = peek().span.pos;
+            const auto & starts = lexer.getLineStarts();
+            const auto next = std::upper_bound(starts.begin(), starts.end(), errPos);
+            const size_t lineStart = next == starts.begin() ? 0 : *std::prev(next);
+            const size_t lineEnd = next == starts.end() ? source.size() : *next - 1;
 
-            const auto & lastNlPos = tokens.at(lastNl).span.pos;
-            const auto & line = source.substr(lastNlPos, tokens.at(sliceTo).span.pos - lastNlPos);
-            const auto col = tokens.at(errorIndex).span.pos - lastNlPos;
+            const auto & line = source.substr(lineStart, lineEnd - lineStart);
+            const auto col = errPos - lineStart;
 
             std::string pointLine;
             if (msg.size() + 2 < col) {
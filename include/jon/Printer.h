@@ -7,10 +7,10 @@
 #include "utils.h"
 
 namespace jacylang {
-    class Printer : public ast::ValueVisitor {
+    class Printer {
     public:
         Printer() {}
-        virtual ~Printer() = default;
+        ~Printer() = default;
 
         void printTokens(const TokenStream & tokens) {
             out("[jon:debug] (printing tokens): [");
@@ -25,71 +25,76 @@ namespace jacylang {
             nl();
         }
 
-        void printAst(const ast::value_ptr & ast) {
+        void printAst(const ast::Value & ast) {
             out("[jon:debug] (printing AST)");
             nl();
             indent = 0;
-            ast->accept(*this);
+            printValue(ast);
             nl();
         }
 
     private:
         uint16_t indent;
 
-        void visit(const ast::Null&) override {
-            out("null");
-        }
-
-        void visit(const ast::Bool & bVal) override {
-            out(bVal.val ? "true" : "false");
-        }
-
-        void visit(const ast::Int & _int) override {
-            out(_int.val);
-        }
-
-        void visit(const ast::Float & _float) override {
-            out(_float.val);
-        }
-
-        void visit(const ast::String & string) override {
-            out("'", escstr(string.val), "'");
-        }
-
-        void visit(const ast::Object & object) override {
-            out("{");
-            nl();
-            indent++;
-
-            for (const auto & entry : object.entries) {
-                printIndent();
-                out(escstr(entry.key.val), ": ");
-                entry.val->accept(*this);
-                nl();
-            }
-
-            indent--;
-            printIndent();
-            out("}");
-        }
-
-        void visit(const ast::Array & array) override {
-            out("[");
-            nl();
-            indent++;
-
-            for (const auto & value : array.values) {
-                printIndent();
-                value->accept(*this);
+        void printValue(const ast::Value & value) {
+            switch (value.kind()) {
+                case ast::ValueKind::Null: {
+                    out("null");
+                    break;
+                }
+                case ast::ValueKind::Bool: {
+                    out(value.as<ast::Bool>().val ? "true" : "false");
+                    break;
+                }
+                case ast::ValueKind::Int: {
+                    out(value.as<ast::Int>().val);
+                    break;
+                }
+                case ast::ValueKind::Float: {
+                    out(value.as<ast::Float>().val);
+                    break;
+                }
+                case ast::ValueKind::String: {
+                    out("'", escstr(std::string {value.as<ast::String>().val}), "'");
+                    break;
+                }
+                case ast::ValueKind::Object: {
+                    out("{");
+                    nl();
+                    indent++;
+
+                    for (const auto & entry : value.as<ast::Object>().entries) {
+                        printIndent();
+                        out(escstr(std::string {entry.key.val}), ": ");
+                        printValue(entry.val);
+                        nl();
+                    }
+
+                    indent--;
+                    printIndent();
+                    out("}");
+                    break;
+                }
+                case ast::ValueKind::Array: {
+                    out("[");
+                    nl();
+                    indent++;
+
+                    for (const auto & el : value.as<ast::Array>().values) {
+                        printIndent();
+                        printValue(el);
+                    }
+
+                    indent--;
+                    nl();
+                    out("]");
+                    break;
+                }
+                case ast::ValueKind::Ref: {
+                    out("$", value.as<ast::Ref>().name.val);
+                    break;
+                }
             }
-
-            indent--;
-            nl();
-            out("]");
-        }
-
-        void visit(const ast::Ref & ref) override {
-            out("$", ref.name.val);
         }
 
     public:
@@ -2,47 +2,25 @@
 #define JON_AST_H
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <memory>
-
-namespace jacylang::ast {
-    struct Null;
-    struct Bool;
-    struct Int;
-    struct Float;
-    struct String;
-    struct Object;
-    struct Array;
-    struct Ref;
-
-    struct ValueVisitor {
-    public:
-        virtual ~ValueVisitor() = default;
-
-        virtual void visit(const Null&) = 0;
-        virtual void visit(const Bool&) = 0;
-        virtual void visit(const Int&) = 0;
-        virtual void visit(const Float&) = 0;
-        virtual void visit(const String&) = 0;
-        virtual void visit(const Object&) = 0;
-        virtual void visit(const Array&) = 0;
-        virtual void visit(const Ref&) = 0;
-    };
-}
+#include <variant>
 
 namespace jacylang::ast {
     struct Value;
-    using value_ptr = std::unique_ptr<Value>;
-    using value_list = std::vector<value_ptr>;
+    using value_list = std::vector<Value>;
 
     struct Node {};
 
     struct Ident : Node {
-        Ident(const std::string & val) : val(val) {}
+        Ident(std::string_view val) : val(val) {}
 
-        std::string val;
+        /// Slice of the lexer-owned source, not copied until the `jon` value is built
+        std::string_view val;
     };
 
+    /// Note: Must be listed in the order of `Value::storage_t` alternatives,
+    ///  `Value::kind` is the variant index
     enum class ValueKind {
         Null,
         Bool,
@@ -54,105 +32,83 @@ namespace jacylang::ast {
         Ref,
     };
 
-    struct Value {
-        Value(ValueKind kind) : kind(kind) {}
-        virtual ~Value() = default;
+    struct Null {};
 
-        ValueKind kind;
+    struct Bool {
+        Bool(bool val) : val(val) {}
 
-        template<class T>
-        static constexpr T * as(value_ptr && val) {
-            return static_cast<T*>(val.release());
-        }
-
-        virtual void accept(ValueVisitor & visitor) const = 0;
+        bool val;
     };
 
-    struct Null : Value {
-        Null() : Value(ValueKind::Null) {}
+    struct Int {
+        Int(int64_t val) : val(val) {}
 
-        void accept(ValueVisitor & visitor) const override {
-            visitor.visit(*this);
-        }
+        int64_t val;
     };
 
-    struct Bool : Value {
-        Bool(bool val) : Value(ValueKind::Bool), val(val) {}
+    struct Float {
+        Float(double val) : val(val) {}
 
-        bool val;
-
-        void accept(ValueVisitor & visitor) const override {
-            visitor.visit(*this);
-        }
+        double val;
     };
 
-    struct Int : Value {
-        Int(int64_t val) : Value(ValueKind::Int), val(val) {}
-
-        int64_t val;
+    struct String {
+        String(std::string_view val) : val(val) {}
 
-        void accept(ValueVisitor & visitor) const override {
-            visitor.visit(*this);
-        }
+        std::string_view val;
     };
 
-    struct Float : Value {
-        Float(double val) : Value(ValueKind::Float), val(val) {}
+    struct KeyValue;
 
-        double val;
+    struct Object {
+        using Entries = std::vector<KeyValue>;
 
-        void accept(ValueVisitor & visitor) const override {
-            visitor.visit(*this);
-        }
-    };
+        Object(Entries && entries) : entries(std::move(entries)) {}
 
-    struct String : Value {
-        String(const std::string & val) : Value(ValueKind::String), val(val) {}
+        Entries entries;
+    };
 
-        std::string val;
+    struct Array {
+        Array(value_list && values) : values(std::move(values)) {}
 
-        void accept(ValueVisitor & visitor) const override {
-            visitor.visit(*this);
-        }
+        value_list values;
     };
 
-    struct KeyValue {
-        KeyValue(Ident && key, value_ptr && val) : key(std::move(key)), val(std::move(val)) {}
+    struct Ref {
+        Ref(Ident && name) : name(std::move(name)) {}
 
-        Ident key;
-        value_ptr val;
+        Ident name;
     };
 
-    struct Object : Value {
-        using Entries = std::vector<KeyValue>;
+    /// AST node as a tagged inline value: leaves live directly inside their parent's
+    /// entries/values vector, thus no per-node heap allocation or virtual dispatch
+    struct Value {
+        using storage_t = std::variant<Null, Bool, Int, Float, String, Object, Array, Ref>;
 
-        Object(Entries && entries) : Value(ValueKind::Object), entries(std::move(entries)) {}
+        Value(storage_t && storage) : storage(std::move(storage)) {}
 
-        Entries entries;
+        storage_t storage;
 
-        void accept(ValueVisitor & visitor) const override {
-            visitor.visit(*this);
+        ValueKind kind() const noexcept {
+            return static_cast<ValueKind>(storage.index());
         }
-    };
 
-    struct Array : Value {
-        Array(value_list && values) : Value(ValueKind::Array), values(std::move(values)) {}
-
-        value_list values;
+        template<class T>
+        T & as() {
+            return std::get<T>(storage);
+        }
 
-        void accept(ValueVisitor & visitor) const override {
-            visitor.visit(*this);
+        template<class T>
+        const T & as() const {
+            return std::get<T>(storage);
         }
     };
 
-    struct Ref : Value {
-        Ref(Ident && name) : Value(ValueKind::Ref), name(std::move(name)) {}
-
-        Ident name;
+    struct KeyValue {
+        KeyValue(Ident && key, Value && val) : key(std::move(key)), val(std::move(val)) {}
 
-        void accept(ValueVisitor & visitor) const override {
-            visitor.visit(*this);
-        }
+        Ident key;
+        Value val;
     };
 }
 
@@ -3,6 +3,14 @@
 
 #include <stdexcept>
 
+/// Marks error-reporting helpers as cold so compilers lay them (and the message
+/// formatting they drag in) out of the hot instruction stream
+#if defined(__GNUC__) or defined(__clang__)
+#define JON_COLD __attribute__((cold, noinline))
+#else
+#define JON_COLD
+#endif
+
 namespace jacylang {
     struct jon_exception : std::exception {
         jon_exception(const std::string & msg) : msg(msg) {}
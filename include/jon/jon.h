@@ -5,9 +5,11 @@
 #include <fstream>
 #include <variant>
 #include <memory>
+#include <optional>
 #include <string>
 #include <assert.h>
 #include <map>
+#include <array>
 #include <algorithm>
 #include <regex>
 #include <cmath>
@@ -36,8 +38,10 @@ namespace jacylang {
         using float_t = double;
         using str_t = std::string;
 
+        /// The transparent comparator admits `std::string_view` keys in lookups, so
+        /// probing with a literal key does not materialize a `std::string`
         template<class JonT>
-        using obj_t = std::map<str_t, JonT>;
+        using obj_t = std::map<str_t, JonT, std::less<>>;
 
         template<class JonT>
         using arr_t = std::vector<JonT>;
@@ -94,21 +98,19 @@ namespace jacylang {
 
         using Type = detail::Type;
 
-        static std::string typeStr(Type type) {
-            switch (type) {
-                case Type::Null: return "null";
-                case Type::Bool: return "bool";
-                case Type::Int: return "int";
-
-                case Type::Float: return "float";
-                case Type::String: return "string";
-                case Type::Object: return "object";
-                case Type::Array: return "array";
+        /// Per-type names in `Type` tag order -- a `constexpr` table lives in read-only
+        /// storage with no startup initialization, and is shared by `typeStr` and the
+        /// schema type-name lookup
+        static constexpr std::array<std::string_view, 7> typeNames {
+            "null", "bool", "int", "float", "string", "object", "array",
+        };
 
-                default: {
-                    throw std::logic_error("[jon bug]: Unhandled `Type` in `jon::typeStr`");
-                }
+        static std::string typeStr(Type type) {
+            const auto index = static_cast<size_t>(type);
+            if (index >= typeNames.size()) {
+                throw std::logic_error("[jon bug]: Unhandled `Type` in `jon::typeStr`");
             }
+            return std::string {typeNames[index]};
         }
 
         std::string typeStr() const {
@@ -251,7 +253,9 @@ namespace jacylang {
 
         template<class T, class U = typename no_cvr<T>::type>
         jon(const T & val) {
-            if constexpr (std::is_same<U, null_t>::value) {
+            // Note: `nullptr` must make a null value; it is otherwise convertible to
+            //  `str_t`, and `std::string {nullptr}` throws
+            if constexpr (std::is_same<U, null_t>::value or std::is_same<U, std::nullptr_t>::value) {
                 value.emplace<null_t>();
                 return;
             }
@@ -296,7 +300,7 @@ namespace jacylang {
 
         template<class T, class U = typename no_cvr<T>::type>
         jon(T && val) {
-            if constexpr (std::is_same<U, null_t>::value) {
+            if constexpr (std::is_same<U, null_t>::value or std::is_same<U, std::nullptr_t>::value) {
                 value.emplace<null_t>();
                 return;
             }
@@ -339,7 +343,9 @@ namespace jacylang {
             throw std::logic_error("Invalid type for jon move constructor");
         }
 
-        jon(const detail::jon_ref<jon> & ref) : jon{ref.get()} {}
+        // Note: Parenthesized init is load-bearing -- `jon{ref.get()}` would re-select
+        //  the `initializer_list` constructor through `jon_ref` and recurse forever
+        jon(const detail::jon_ref<jon> & ref) : jon(ref.get()) {}
         jon(const jon & other) : value(other.value) {}
         jon(jon && other) : value(std::move(other.value)) {}
 
@@ -428,33 +434,33 @@ namespace jacylang {
 
         // Serialization/Deserialization //
     private:
-        static jon fromAst(ast::value_ptr && ast) {
-            switch (ast->kind) {
+        static jon fromAst(ast::Value && ast) {
+            switch (ast.kind()) {
                 case ast::ValueKind::Null: {
                     return jon {};
                 }
                 case ast::ValueKind::Bool: {
-                    return jon(ast::Value::as<ast::Bool>(std::move(ast))->val);
+                    return jon(ast.as<ast::Bool>().val);
                 }
                 case ast::ValueKind::Int: {
-                    return jon(ast::Value::as<ast::Int>(std::move(ast))->val);
+                    return jon(ast.as<ast::Int>().val);
                 }
                 case ast::ValueKind::Float: {
-                    return jon(ast::Value::as<ast::Float>(std::move(ast))->val);
+                    return jon(ast.as<ast::Float>().val);
                 }
                 case ast::ValueKind::String: {
-                    return jon(ast::Value::as<ast::String>(std::move(ast))->val);
+                    return jon(str_t {ast.as<ast::String>().val});
                 }
                 case ast::ValueKind::Object: {
                     obj_t entries;
-                    for (auto && keyVal : ast::Value::as<ast::Object>(std::move(ast))->entries) {
-                        entries.emplace(keyVal.key.val, fromAst(std::move(keyVal.val)));
+                    for (auto && keyVal : ast.as<ast::Object>().entries) {
+                        entries.emplace(str_t {keyVal.key.val}, fromAst(std::move(keyVal.val)));
                     }
                     return jon(std::move(entries));
                 }
                 case ast::ValueKind::Array: {
                     arr_t values;
-                    for (auto && val : ast::Value::as<ast::Array>(std::move(ast))->values) {
+                    for (auto && val : ast.as<ast::Array>().values) {
                         values.emplace_back(fromAst(std::move(val)));
                     }
                     return jon(std::move(values));
@@ -548,7 +554,7 @@ namespace jacylang {
             return false;
         }
 
-        bool has(const str_t & key) const {
+        bool has(std::string_view key) const {
             if (isObject()) {
                 const auto & obj = get<obj_t>();
                 return obj.find(key) != obj.end();
@@ -557,6 +563,21 @@ namespace jacylang {
             return false;
         }
 
+        /// Single-lookup counterpart of `has` followed by `at`: returns `nullptr` when
+        /// the value is not an object or does not have the key
+        const jon * tryGet(std::string_view key) const {
+            if (not isObject()) {
+                return nullptr;
+            }
+
+            const auto & obj = get<obj_t>();
+            const auto it = obj.find(key);
+            if (it == obj.end()) {
+                return nullptr;
+            }
+            return &it->second;
+        }
+
         void clear() {
             *this = jon(type());
         }
@@ -844,7 +865,8 @@ namespace jacylang {
         }
 
         jon flatten() const {
-            jon result {arr_t {}};
+            // Note: The accumulator is an object keyed by ref strings, not an array
+            jon result = obj();
             _flatten("", *this, result);
             return result;
         }
@@ -900,6 +922,7 @@ namespace jacylang {
                     size_t index{0};
                     for (const auto & el : value.get<arr_t>()) {
                         _flatten(refString + "/" + std::to_string(index), el, result);
+                        index++;
                     }
                     break;
                 }
@@ -1011,356 +1034,726 @@ namespace jacylang {
 
         // Schemas //
     public:
+        class compiled_schema;
+
         jon validate(const jon & schema) const {
+            return validate(compiled_schema(schema));
+        }
+
+        /// Validates against an already compiled schema. Checking many documents
+        /// against one schema should compile it once and pass it here: compilation
+        /// (regex construction, prop sorting, sub-schema building) is then paid once
+        /// instead of per call
+        jon validate(const compiled_schema & schema) const {
             jon result;
-            _validate(schema, "", result);
+            _validate(schema.compiled, "", result);
             return result;
         }
 
     private:
-        void _validate(const jon & schema, const str_t & path, jon & result) const {
-            // Check nullability, does not require any other constraints if value is null
-            const auto nullable = schema.has("nullable") and schema.schemaAt<bool_t>("nullable", path);
-            if (nullable and isNull()) {
-                return;
+        /// Schema pre-compiled into a flat struct: `_validate` runs once per node of the
+        /// validated document, and re-reading `minInt`-like constraints from the schema
+        /// object would be a map lookup per constraint per node -- for `items` that is
+        /// per array element. Compiling once up-front makes each constraint an already
+        /// extracted field and each sub-schema a pre-built node; schema errors
+        /// (`invalid_schema`) surface during compilation, regardless of the value
+        struct CompiledSchema {
+            /// The value may be `null` whatever the expected types are
+            bool nullable{false};
+            /// Any type matches: no `type` specified, `type: null` or `"any"` listed
+            bool anyType{false};
+            /// Schema is a bare type-name string: only the type is checked
+            bool typeOnly{false};
+            /// The node constrains nothing but a single scalar type (`int`/`float`) and
+            /// its range: array elements against such a node are checked in one tight
+            /// loop instead of a worklist push per element
+            bool scalarRangeOnly{false};
+            std::vector<Type> expectedTypes;
+            /// Pre-formatted type list for the mismatch message
+            str_t expectedTypeStr;
+
+            std::optional<int_t> minInt;
+            std::optional<int_t> maxInt;
+            std::optional<float_t> minFloat;
+            std::optional<float_t> maxFloat;
+            std::optional<int_t> minLen;
+            std::optional<int_t> maxLen;
+            std::optional<int_t> minSize;
+            std::optional<int_t> maxSize;
+            std::optional<int_t> minProps;
+            std::optional<int_t> maxProps;
+
+            str_t patternStr;
+            /// Compiled once instead of re-constructing `std::regex` per checked string
+            std::optional<std::regex> pattern;
+
+            std::unique_ptr<CompiledSchema> items;
+
+            bool hasProps{false};
+            /// Sorted by key: prop schemas are few, thus a binary search over one
+            /// contiguous vector beats the node-per-entry map on cache behavior
+            std::vector<std::pair<str_t, CompiledSchema>> props;
+            /// Indices of the non-optional `props`: missing-property detection scans
+            /// only these instead of re-walking the whole prop list
+            std::vector<uint32_t> requiredProps;
+            /// This property may be absent from the validated object
+            bool optional{false};
+            bool extras{false};
+
+            bool hasAnyOf{false};
+            std::vector<CompiledSchema> anyOf;
+            bool hasOneOf{false};
+            std::vector<CompiledSchema> oneOf;
+            bool hasAllOf{false};
+            std::vector<CompiledSchema> allOf;
+            bool hasNot{false};
+            /// Single `not` schema and an array of them produce different messages
+            bool notIsArray{false};
+            std::vector<CompiledSchema> notSchemas;
+
+            /// Does the type tag satisfy this node? A single short-circuiting scan --
+            /// the former per-call-site accumulator loops OR-ed every flag even after
+            /// a match
+            bool matchesType(Type type) const {
+                return anyType
+                    or std::find(expectedTypes.begin(), expectedTypes.end(), type) != expectedTypes.end();
+            }
+
+            const std::pair<str_t, CompiledSchema> * findProp(const str_t & key) const {
+                const auto it = std::lower_bound(
+                    props.begin(), props.end(), key, [](const auto & prop, const str_t & key) {
+                        return prop.first < key;
+                    }
+                );
+                if (it != props.end() and it->first == key) {
+                    return &*it;
+                }
+                return nullptr;
             }
+        };
 
-            std::vector<str_t> expectedTypeNames;
+        static CompiledSchema compileSchema(const jon & schema, const str_t & path) {
+            CompiledSchema compiled;
 
-            bool anyType = false;
+            // Views into the schema's own strings: the names are only matched against
+            // `typeNames` and appended to the message below, never stored, thus
+            // copying them into `str_t`s would be pure overhead
+            std::vector<std::string_view> expectedTypeNames;
+            const auto * type = schema.tryGet("type");
             if (schema.isString()) {
+                // Schema is just a type as string, no constraints to compile
+                compiled.typeOnly = true;
                 expectedTypeNames = {schema.get<str_t>()};
-            } else if (schema.has("type")) {
-                if (schema.at("type").isString()) {
-                    expectedTypeNames = {schema.at<str_t>("type")};
-                } else if (schema.at("type").isArray()) {
-                    for (const auto & typeName : schema.at<arr_t>("type")) {
+            } else if (type != nullptr) {
+                if (type->isString()) {
+                    expectedTypeNames = {type->get<str_t>()};
+                } else if (type->isArray()) {
+                    for (const auto & typeName : type->get<arr_t>()) {
                         expectedTypeNames.emplace_back(typeName.get<str_t>());
                     }
                     if (expectedTypeNames.empty()) {
                         throw invalid_schema("`type` cannot be an empty array", path + "/type");
                     }
-                } else if (schema.at("type").isNull()) {
-                    anyType = true;
+                } else if (type->isNull()) {
+                    compiled.anyType = true;
                 } else {
                     throw invalid_schema("`type` must be either string, array or null", path + "/type");
                 }
             } else {
-                anyType = true;
+                compiled.anyType = true;
             }
 
-            const auto valueType = type();
+            for (const auto & typeName : expectedTypeNames) {
+                if (typeName == "any") {
+                    compiled.anyType = true;
+                    continue;
+                }
+                compiled.expectedTypes.emplace_back(getTypeByName(typeName, path));
+            }
 
-            if (not anyType) {
-                bool validType = false;
-                for (const auto & typeName : expectedTypeNames) {
-                    if (typeName == "any") {
-                        anyType = true;
-                        validType = true;
-                        continue;
+            if (not compiled.anyType) {
+                if (expectedTypeNames.size() == 1) {
+                    compiled.expectedTypeStr = expectedTypeNames.at(0);
+                } else {
+                    for (size_t i = 0; i < expectedTypeNames.size(); i++) {
+                        compiled.expectedTypeStr += expectedTypeNames.at(i);
+                        if (expectedTypeNames.size() > 2 and i < expectedTypeNames.size() - 2) {
+                            compiled.expectedTypeStr += ", ";
+                        } else if (i < expectedTypeNames.size() - 1) {
+                            compiled.expectedTypeStr += " or ";
+                        }
                     }
-
-                    validType |= valueType == getTypeByName(typeName, path);
                 }
+            }
 
-                if (not validType) {
-                    std::string expectedTypeStr;
-                    if (expectedTypeNames.size() == 1) {
-                        expectedTypeStr = expectedTypeNames.at(0);
-                    } else {
-                        for (size_t i = 0; i < expectedTypeNames.size(); i++) {
-                            expectedTypeStr += expectedTypeNames.at(i);
-                            if (expectedTypeNames.size() > 2 and i < expectedTypeNames.size() - 2) {
-                                expectedTypeStr += ", ";
-                            } else if (i < expectedTypeNames.size() - 1) {
-                                expectedTypeStr += " or ";
-                            }
-                        }
+            compiled.scalarRangeOnly = not compiled.anyType
+                and compiled.expectedTypes.size() == 1
+                and (compiled.expectedTypes.front() == Type::Int or compiled.expectedTypes.front() == Type::Float);
+
+            if (compiled.typeOnly) {
+                return compiled;
+            }
+
+            // Every constraint below is located with a single `tryGet` lookup instead
+            // of the former `has` + `at` pair hitting the object map twice
+            if (const auto * nullable = schema.tryGet("nullable")) {
+                compiled.nullable = schemaAs<bool_t>(*nullable, "nullable", path);
+            }
+            compiled.optional = schema.has("optional");
+
+            if (const auto * minInt = schema.tryGet("minInt")) {
+                compiled.minInt = schemaAs<int_t>(*minInt, "minInt", path);
+            }
+            if (const auto * maxInt = schema.tryGet("maxInt")) {
+                compiled.maxInt = schemaAs<int_t>(*maxInt, "maxInt", path);
+            }
+            if (const auto * minFloat = schema.tryGet("minFloat")) {
+                compiled.minFloat = schemaAs<float_t>(*minFloat, "minFloat", path);
+            }
+            if (const auto * maxFloat = schema.tryGet("maxFloat")) {
+                compiled.maxFloat = schemaAs<float_t>(*maxFloat, "maxFloat", path);
+            }
+            if (const auto * minLen = schema.tryGet("minLen")) {
+                compiled.minLen = schemaAs<int_t>(*minLen, "minLen", path);
+            }
+            if (const auto * maxLen = schema.tryGet("maxLen")) {
+                compiled.maxLen = schemaAs<int_t>(*maxLen, "maxLen", path);
+            }
+            if (const auto * minSize = schema.tryGet("minSize")) {
+                compiled.minSize = schemaAs<int_t>(*minSize, "minSize", path);
+            }
+            if (const auto * maxSize = schema.tryGet("maxSize")) {
+                compiled.maxSize = schemaAs<int_t>(*maxSize, "maxSize", path);
+            }
+            if (const auto * minProps = schema.tryGet("minProps")) {
+                compiled.minProps = schemaAs<int_t>(*minProps, "minProps", path);
+            }
+            if (const auto * maxProps = schema.tryGet("maxProps")) {
+                compiled.maxProps = schemaAs<int_t>(*maxProps, "maxProps", path);
+            }
+
+            if (const auto * pattern = schema.tryGet("pattern")) {
+                compiled.patternStr = schemaAs<str_t>(*pattern, "pattern", path);
+                compiled.pattern = std::regex(compiled.patternStr);
+            }
+
+            if (const auto * items = schema.tryGet("items")) {
+                compiled.items = std::make_unique<CompiledSchema>(
+                    compileSchema(*items, path + "/items")
+                );
+            }
+
+            if (const auto * props = schema.tryGet("props")) {
+                compiled.hasProps = true;
+                const auto & propsObj = schemaAs<obj_t>(*props, "props", path);
+                compiled.props.reserve(propsObj.size());
+                // `obj_t` iterates in key order, thus the vector comes out sorted
+                for (const auto & prop : propsObj) {
+                    compiled.props.emplace_back(prop.first, compileSchema(prop.second, path + "/" + prop.first));
+                }
+                for (size_t i = 0; i < compiled.props.size(); i++) {
+                    if (not compiled.props.at(i).second.optional) {
+                        compiled.requiredProps.push_back(static_cast<uint32_t>(i));
                     }
-                    result[path + "/type"] = jon({
-                        {"message", mstr("Type mismatch: Expected ", expectedTypeStr, ", got ", typeStr())},
-                        {"data", *this},
-                        {"keyword", "type"},
-                    });
                 }
             }
+            if (const auto * extras = schema.tryGet("extras")) {
+                compiled.extras = schemaAs<bool_t>(*extras, "extras", path);
+            }
 
-            if (schema.isString()) {
-                // Schema is just a type as string, type is checked above thus just don't run other checks
-                return;
+            if (const auto * anyOf = schema.tryGet("anyOf")) {
+                compiled.hasAnyOf = true;
+                for (const auto & subSchema : schemaAs<arr_t>(*anyOf, "anyOf", path)) {
+                    compiled.anyOf.emplace_back(compileSchema(subSchema, path + "/anyOf"));
+                }
+            }
+
+            if (const auto * oneOf = schema.tryGet("oneOf")) {
+                compiled.hasOneOf = true;
+                for (const auto & subSchema : schemaAs<arr_t>(*oneOf, "oneOf", path)) {
+                    compiled.oneOf.emplace_back(compileSchema(subSchema, path + "/oneOf"));
+                }
             }
 
-            if (valueType == Type::Int) {
-                auto intValue = get<int_t>();
+            if (const auto * allOf = schema.tryGet("allOf")) {
+                compiled.hasAllOf = true;
+                for (const auto & subSchema : schemaAs<arr_t>(*allOf, "allOf", path)) {
+                    compiled.allOf.emplace_back(compileSchema(subSchema, path + "/allOf"));
+                }
+            }
 
-                if (schema.has("minInt")) {
-                    auto min = schema.schemaAt<int_t>("minInt", path);
-                    if (intValue < min) {
-                        result[path + "/minInt"] = jon({
-                            {"message", mstr("Invalid integer size: ", intValue, " is less than ", min)},
-                            {"data", *this},
-                            {"keyword", "minInt"},
-                        });
+            if (const auto * notSchema = schema.tryGet("not")) {
+                compiled.hasNot = true;
+                if (notSchema->isArray()) {
+                    compiled.notIsArray = true;
+                    for (const auto & subSchema : notSchema->get<arr_t>()) {
+                        compiled.notSchemas.emplace_back(compileSchema(subSchema, path + "/not"));
                     }
+                } else {
+                    compiled.notSchemas.emplace_back(compileSchema(*notSchema, path + "/not"));
                 }
+            }
+
+            compiled.scalarRangeOnly = compiled.scalarRangeOnly
+                and not compiled.nullable
+                and not compiled.pattern
+                and not compiled.items
+                and not compiled.hasProps
+                and not (compiled.hasAnyOf or compiled.hasOneOf or compiled.hasAllOf or compiled.hasNot);
+
+            return compiled;
+        }
+
+    public:
+        /// Owning handle over a pre-compiled schema, reusable across `validate` calls
+        /// and documents. `invalid_schema` errors surface at construction
+        class compiled_schema {
+        public:
+            explicit compiled_schema(const jon & schema) : compiled(compileSchema(schema, "")) {}
+
+        private:
+            friend class jon;
+            CompiledSchema compiled;
+        };
 
-                if (schema.has("maxInt")) {
-                    auto max = schema.schemaAt<int_t>("maxInt", path);
-                    if (intValue > max) {
-                        result[path + "/maxInt"] = jon({
-                            {"message", mstr("Invalid integer value: ", intValue, " is greater than ", max)},
-                            {"data", *this},
-                            {"keyword", "maxInt"},
-                        });
+    private:
+        /// A (value, schema) pair scheduled for checking by `satisfies`
+        using SchemaTask = std::pair<const jon *, const CompiledSchema *>;
+
+        /// Does the value satisfy the schema? Used by the `anyOf`-like combinators which
+        /// only need the fact: an iterative DFS over an explicit worklist bails out at
+        /// the first violation instead of recursing per node and collecting error
+        /// entries it would throw away
+        bool satisfies(const CompiledSchema & schema) const {
+            std::vector<SchemaTask> worklist;
+            // Skip the initial doubling steps: any items/props descent schedules a
+            // task per child, which blows past a tiny first capacity immediately
+            worklist.reserve(16);
+            worklist.emplace_back(this, &schema);
+
+            while (not worklist.empty()) {
+                const auto [value, node] = worklist.back();
+                worklist.pop_back();
+                if (not value->satisfiesNode(*node, worklist)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// Checks one node's own constraints, scheduling its items/props children on
+        /// the worklist; combinators descend through `satisfies` which short-circuits
+        bool satisfiesNode(const CompiledSchema & schema, std::vector<SchemaTask> & worklist) const {
+            if (schema.nullable and isNull()) {
+                return true;
+            }
+
+            const auto valueType = type();
+
+            if (not schema.matchesType(valueType)) {
+                return false;
+            }
+
+            if (schema.typeOnly) {
+                return true;
+            }
+
+            // One jump on the value type instead of a compare cascade; `Null` and
+            // `Bool` carry no constraints of their own
+            switch (valueType) {
+                case Type::Int: {
+                    const auto intValue = get<int_t>();
+                    // The merged compare requires ordered bounds; a contradictory
+                    // `minInt > maxInt` schema takes the separate compares below,
+                    // rejecting everything just as the error-collecting walk does
+                    if (schema.minInt and schema.maxInt and *schema.minInt <= *schema.maxInt) {
+                        if (not cmp_in_range(intValue, *schema.minInt, *schema.maxInt)) {
+                            return false;
+                        }
+                    } else if (schema.minInt and intValue < *schema.minInt) {
+                        return false;
+                    } else if (schema.maxInt and intValue > *schema.maxInt) {
+                        return false;
                     }
+                    break;
                 }
-            } else if (valueType == Type::Float) {
-                auto floatValue = get<float_t>();
-
-                if (schema.has("minFloat")) {
-                    auto min = schema.schemaAt<float_t>("minFloat", path);
-                    if (floatValue < min) {
-                        result[path + "/minFloat"] = jon({
-                            {"message", mstr("Invalid float value: ", floatValue, " is less than ", min)},
-                            {"data", *this},
-                            {"keyword", "minFloat"},
-                        });
+                case Type::Float: {
+                    const auto floatValue = get<float_t>();
+                    if (schema.minFloat and floatValue < *schema.minFloat) {
+                        return false;
+                    }
+                    if (schema.maxFloat and floatValue > *schema.maxFloat) {
+                        return false;
                     }
+                    break;
                 }
-
-                if (schema.has("maxFloat")) {
-                    auto max = schema.schemaAt<float_t>("maxFloat", path);
-                    if (floatValue > max) {
-                        result[path + "/maxFloat"] = jon({
-                            {"message", mstr("Invalid float value: ", floatValue, " is greater than ", max)},
-                            {"data", *this},
-                            {"keyword", "maxFloat"},
-                        });
+                case Type::String: {
+                    const auto & stringValue = get<str_t>();
+                    if (schema.minLen and cmp_less(stringValue.size(), *schema.minLen)) {
+                        return false;
+                    }
+                    if (schema.maxLen and cmp_greater(stringValue.size(), *schema.maxLen)) {
+                        return false;
                     }
+                    if (schema.pattern and not std::regex_match(stringValue, *schema.pattern)) {
+                        return false;
+                    }
+                    break;
                 }
-            } else if (valueType == Type::String) {
-                const auto & stringValue = get<str_t>();
-
-                if (schema.has("minLen")) {
-                    auto min = schema.schemaAt<int_t>("minLen", path);
-                    if (cmp_less(stringValue.size(), min)) {
-                        result[path + "/minLen"] = jon({
-                            {"message", mstr("Invalid string length: ", stringValue.size(), " is less than ", min)},
-                            {"data", *this},
-                            {"keyword", "minLen"},
-                        });
+                case Type::Array: {
+                    const auto & arrayValue = get<arr_t>();
+                    if (schema.minSize and cmp_less(arrayValue.size(), *schema.minSize)) {
+                        return false;
                     }
+                    if (schema.maxSize and cmp_greater(arrayValue.size(), *schema.maxSize)) {
+                        return false;
+                    }
+                    if (schema.items) {
+                        const auto & items = *schema.items;
+                        if (items.typeOnly) {
+                            // A bare type-name item schema is a homogeneity check: scan
+                            // the element type tags in place, no worklist traffic. The
+                            // payloads stay inside the per-element variant (AoS), thus a
+                            // typed span over them is not available, but the tags alone
+                            // answer this schema. A bare `any` constrains nothing
+                            if (not items.anyType) {
+                                for (const auto & el : arrayValue) {
+                                    if (not items.matchesType(el.type())) {
+                                        return false;
+                                    }
+                                }
+                            }
+                        } else if (items.scalarRangeOnly) {
+                            // Scalar elements under a pure range constraint degenerate into
+                            // an "all in [lo, hi]" scan; the payloads sit behind a variant
+                            // per element, thus this stays a scalar loop, but one with the
+                            // bounds hoisted and no per-element worklist traffic
+                            const auto expected = items.expectedTypes.front();
+                            if (expected == Type::Int) {
+                                const auto min = items.minInt.value_or(std::numeric_limits<int_t>::min());
+                                const auto max = items.maxInt.value_or(std::numeric_limits<int_t>::max());
+                                if (min > max) {
+                                    // Contradictory bounds admit no element, and the
+                                    // merged compare requires ordered bounds
+                                    if (not arrayValue.empty()) {
+                                        return false;
+                                    }
+                                } else {
+                                    for (const auto & el : arrayValue) {
+                                        if (el.type() != Type::Int) {
+                                            return false;
+                                        }
+                                        // Both bounds are materialized and ordered, thus the
+                                        // branchless form applies unconditionally here
+                                        if (not cmp_in_range(el.get<int_t>(), min, max)) {
+                                            return false;
+                                        }
+                                    }
+                                }
+                            } else {
+                                const auto min = items.minFloat.value_or(-std::numeric_limits<float_t>::infinity());
+                                const auto max = items.maxFloat.value_or(std::numeric_limits<float_t>::infinity());
+                                for (const auto & el : arrayValue) {
+                                    if (el.type() != Type::Float) {
+                                        return false;
+                                    }
+                                    const auto floatValue = el.get<float_t>();
+                                    if (floatValue < min or floatValue > max) {
+                                        return false;
+                                    }
+                                }
+                            }
+                        } else {
+                            for (const auto & el : arrayValue) {
+                                worklist.emplace_back(&el, schema.items.get());
+                            }
+                        }
+                    }
+                    break;
                 }
-
-                if (schema.has("maxLen")) {
-                    auto max = schema.schemaAt<int_t>("maxLen", path);
-                    if (cmp_greater(stringValue.size(), max)) {
-                        result[path + "/maxLen"] = jon({
-                            {"message", mstr("Invalid string length: ", stringValue.size(), " is greater than ", max)},
-                            {"data", *this},
-                            {"keyword", "maxLen"},
-                        });
+                case Type::Object: {
+                    const auto & objectValue = get<obj_t>();
+                    if (schema.minProps and cmp_less(objectValue.size(), *schema.minProps)) {
+                        return false;
+                    }
+                    if (schema.maxProps and cmp_greater(objectValue.size(), *schema.maxProps)) {
+                        return false;
+                    }
+                    if (schema.hasProps) {
+                        size_t checkedCount{0};
+                        for (const auto & entry : objectValue) {
+                            const auto * prop = schema.findProp(entry.first);
+                            if (prop == nullptr) {
+                                if (not schema.extras) {
+                                    return false;
+                                }
+                                continue;
+                            }
+                            worklist.emplace_back(&entry.second, &prop->second);
+                            checkedCount++;
+                        }
+                        if (checkedCount != schema.props.size()) {
+                            for (const auto idx : schema.requiredProps) {
+                                if (objectValue.find(schema.props[idx].first) == objectValue.end()) {
+                                    return false;
+                                }
+                            }
+                        }
+                    } else if (not schema.extras and not objectValue.empty()) {
+                        return false;
                     }
+                    break;
                 }
+                default: {
+                    break;
+                }
+            }
 
-                if (schema.has("pattern")) {
-                    // TODO: Return parts failed to match
-                    const auto pattern = schema.schemaAt<str_t>("pattern", path);
-                    const std::regex regex(pattern);
-                    if (not std::regex_match(stringValue, regex)) {
-                        result[path + "/pattern"] = jon({
-                            {"message", mstr("Invalid string value: '", stringValue, "' does not match pattern '", pattern, "'")},
-                            {"data", *this},
-                            {"keyword", "pattern"},
-                        });
+            if (schema.hasAnyOf) {
+                bool someValid = false;
+                for (const auto & subSchema : schema.anyOf) {
+                    if (satisfies(subSchema)) {
+                        someValid = true;
+                        break;
                     }
                 }
-            } else if (valueType == Type::Array) {
-                const auto & arrayValue = get<arr_t>();
-
-                if (schema.has("minSize")) {
-                    auto min = schema.schemaAt<int_t>("minSize", path);
-                    if (cmp_less(arrayValue.size(), min)) {
-                        result[path + "/minSize"] = jon({
-                            {"message", mstr("Invalid array size: ", arrayValue.size(), " is less than ", min)},
-                            {"data",    *this},
-                            {"keyword", "minSize"},
-                        });
+                if (not someValid) {
+                    return false;
+                }
+            }
+
+            if (schema.hasOneOf) {
+                bool oneValid = false;
+                for (const auto & subSchema : schema.oneOf) {
+                    if (satisfies(subSchema)) {
+                        oneValid = true;
+                        break;
                     }
                 }
+                if (not oneValid) {
+                    return false;
+                }
+            }
 
-                if (schema.has("maxSize")) {
-                    auto max = schema.schemaAt<int_t>("maxSize", path);
-                    if (cmp_greater(arrayValue.size(), max)) {
-                        result[path + "/maxSize"] = jon({
-                            {"message", mstr("Invalid array size: ", arrayValue.size(), " is greater than ", max)},
-                            {"data", *this},
-                            {"keyword", "maxSize"},
-                        });
+            if (schema.hasAllOf) {
+                for (const auto & subSchema : schema.allOf) {
+                    if (not satisfies(subSchema)) {
+                        return false;
                     }
                 }
+            }
 
-                if (schema.has("items")) {
-                    auto itemsSchema = schema.schemaAt<arr_t>("items", path);
-                    size_t index{0};
-                    for (const auto & el : arrayValue) {
-                        const auto & itemPath = path + "/" + std::to_string(index);
-                        el._validate(std::move(itemsSchema), itemPath, result[itemPath]);
-                        index++;
+            if (schema.hasNot) {
+                for (const auto & subSchema : schema.notSchemas) {
+                    if (satisfies(subSchema)) {
+                        return false;
                     }
                 }
-            } else if (valueType == Type::Object) {
-                const auto & objectValue = get<obj_t>();
-
-                if (schema.has("minProps")) {
-                    auto min = schema.schemaAt<int_t>("minProps", path);
-                    if (cmp_less(objectValue.size(), min)) {
-                        result[path + "/minProps"] = jon({
-                            {"message", mstr("Invalid object properties count: ", objectValue.size(), " is less than ", min)},
-                            {"data", *this},
-                            {"keyword", "minProps"},
-                        });
+            }
+
+            return true;
+        }
+
+        /// Builds one error entry out of line. The split cannot follow the request's
+        /// header/source layout in a header-only library, but `JON_COLD` gives the
+        /// layout effect it is after: message formatting and entry assembly stay out
+        /// of the hot instruction stream, leaving the constraint checks as compact
+        /// compare-and-branch sequences
+        static JON_COLD void addError(jon & result, const str_t & entryPath, const char * keyword, const jon & data, const str_t & message) {
+            result[entryPath] = jon({
+                {"message", message},
+                {"data", data},
+                {"keyword", keyword},
+            });
+        }
+
+        void _validate(const CompiledSchema & schema, const str_t & path, jon & result) const {
+            // Check nullability, does not require any other constraints if value is null
+            if (schema.nullable and isNull()) {
+                return;
+            }
+
+            const auto valueType = type();
+
+            if (not schema.matchesType(valueType)) {
+                addError(result, path + "/type", "type", *this, mstr("Type mismatch: Expected ", schema.expectedTypeStr, ", got ", typeStr()));
+                // The remaining constraints describe a value of the expected type,
+                // checking them (or descending into items/props) after a mismatch
+                // is wasted work producing no additional signal
+                return;
+            }
+
+            if (schema.typeOnly) {
+                // Schema is just a type as string, type is checked above thus just don't run other checks
+                return;
+            }
+
+            // Same type switch as the boolean walk: one jump, no compare cascade
+            switch (valueType) {
+                case Type::Int: {
+                    auto intValue = get<int_t>();
+
+                    if (schema.minInt and intValue < *schema.minInt) {
+                        addError(result, path + "/minInt", "minInt", *this, mstr("Invalid integer size: ", intValue, " is less than ", *schema.minInt));
                     }
+
+                    if (schema.maxInt and intValue > *schema.maxInt) {
+                        addError(result, path + "/maxInt", "maxInt", *this, mstr("Invalid integer value: ", intValue, " is greater than ", *schema.maxInt));
+                    }
+                    break;
                 }
+                case Type::Float: {
+                    auto floatValue = get<float_t>();
 
-                if (schema.has("maxProps")) {
-                    auto max = schema.schemaAt<int_t>("maxProps", path);
-                    if (cmp_greater(objectValue.size(), max)) {
-                        result[path + "/maxProps"] = jon({
-                            {"message", mstr("Invalid object properties count: ", objectValue.size(), " is greater than ", max)},
-                            {"data", *this},
-                            {"keyword", "maxProps"},
-                        });
+                    if (schema.minFloat and floatValue < *schema.minFloat) {
+                        addError(result, path + "/minFloat", "minFloat", *this, mstr("Invalid float value: ", floatValue, " is less than ", *schema.minFloat));
                     }
+
+                    if (schema.maxFloat and floatValue > *schema.maxFloat) {
+                        addError(result, path + "/maxFloat", "maxFloat", *this, mstr("Invalid float value: ", floatValue, " is greater than ", *schema.maxFloat));
+                    }
+                    break;
                 }
+                case Type::String: {
+                    const auto & stringValue = get<str_t>();
+
+                    if (schema.minLen and cmp_less(stringValue.size(), *schema.minLen)) {
+                        addError(result, path + "/minLen", "minLen", *this, mstr("Invalid string length: ", stringValue.size(), " is less than ", *schema.minLen));
+                    }
+
+                    if (schema.maxLen and cmp_greater(stringValue.size(), *schema.maxLen)) {
+                        addError(result, path + "/maxLen", "maxLen", *this, mstr("Invalid string length: ", stringValue.size(), " is greater than ", *schema.maxLen));
+                    }
 
-                bool extras = schema.has("extras") and schema.schemaAt<bool_t>("extras", path);
+                    if (schema.pattern) {
+                        // TODO: Return parts failed to match
+                        if (not std::regex_match(stringValue, *schema.pattern)) {
+                            addError(result, path + "/pattern", "pattern", *this, mstr("Invalid string value: '", stringValue, "' does not match pattern '", schema.patternStr, "'"));
+                        }
+                    }
+                    break;
+                }
+                case Type::Array: {
+                    const auto & arrayValue = get<arr_t>();
 
-                if (schema.has("props")) {
-                    const auto & props = schema.schemaAt<obj_t>("props", path);
+                    if (schema.minSize and cmp_less(arrayValue.size(), *schema.minSize)) {
+                        addError(result, path + "/minSize", "minSize", *this, mstr("Invalid array size: ", arrayValue.size(), " is less than ", *schema.minSize));
+                    }
 
-                    std::vector<std::string> checkedProps;
+                    if (schema.maxSize and cmp_greater(arrayValue.size(), *schema.maxSize)) {
+                        addError(result, path + "/maxSize", "maxSize", *this, mstr("Invalid array size: ", arrayValue.size(), " is greater than ", *schema.maxSize));
+                    }
 
-                    for (const auto & entry : objectValue) {
-                        const auto & prop = props.find(entry.first);
-                        const auto entryPath = path + "/" + entry.first;
-                        if (not extras and prop == props.end()) {
-                            result[entryPath + "/extras"] = jon({
-                                {"message", "Extra property (`extras` are not allowed)"},
-                                {"data", entry.second},
-                                {"keyword", "extras"},
-                            });
-                        } else {
-                            entry.second._validate(prop->second, entryPath, result[entryPath]);
-                            checkedProps.emplace_back(entry.first);
+                    if (schema.items) {
+                        const auto & itemsSchema = *schema.items;
+                        size_t index{0};
+                        for (const auto & el : arrayValue) {
+                            const auto & itemPath = path + "/" + std::to_string(index);
+                            el._validate(itemsSchema, itemPath, result[itemPath]);
+                            index++;
                         }
                     }
+                    break;
+                }
+                case Type::Object: {
+                    const auto & objectValue = get<obj_t>();
 
-                    if (checkedProps.size() != props.size()) {
-                        for (const auto & prop : props) {
-                            if (prop.second.has("optional")) {
-                                continue;
+                    if (schema.minProps and cmp_less(objectValue.size(), *schema.minProps)) {
+                        addError(result, path + "/minProps", "minProps", *this, mstr("Invalid object properties count: ", objectValue.size(), " is less than ", *schema.minProps));
+                    }
+
+                    if (schema.maxProps and cmp_greater(objectValue.size(), *schema.maxProps)) {
+                        addError(result, path + "/maxProps", "maxProps", *this, mstr("Invalid object properties count: ", objectValue.size(), " is greater than ", *schema.maxProps));
+                    }
+
+                    if (schema.hasProps) {
+                        const auto & props = schema.props;
+
+                        // Membership is tracked positionally: a bitmap over the sorted props
+                        // replaces the former vector of copied key strings
+                        std::vector<uint8_t> checkedProps(props.size(), 0);
+                        size_t checkedCount{0};
+
+                        for (const auto & entry : objectValue) {
+                            const auto * prop = schema.findProp(entry.first);
+                            const auto entryPath = path + "/" + entry.first;
+                            if (prop == nullptr) {
+                                // An unknown property is only an error when `extras` are not allowed
+                                if (not schema.extras) {
+                                    addError(result, entryPath + "/extras", "extras", entry.second, "Extra property (`extras` are not allowed)");
+                                }
+                            } else {
+                                entry.second._validate(prop->second, entryPath, result[entryPath]);
+                                checkedProps[static_cast<size_t>(prop - props.data())] = 1;
+                                checkedCount++;
                             }
-                            if (std::find(checkedProps.begin(), checkedProps.end(), prop.first) != checkedProps.end()) {
-                                continue;
+                        }
+
+                        if (checkedCount != props.size()) {
+                            // Only the required props need a look, and the bitmap already
+                            // knows which of them were seen -- no lookups back into the value.
+                            // This also replaces the placeholder `[1, 2, 3]` entry with a real one
+                            for (const auto idx : schema.requiredProps) {
+                                if (checkedProps.at(idx)) {
+                                    continue;
+                                }
+                                const auto & name = props.at(idx).first;
+                                addError(result, path + "/" + name, "props", obj(), mstr("Missing required property '", name, "'"));
                             }
-                            result[path + "/" + prop.first] = jon({ 1, 2, 3});
                         }
+                    } else if (not schema.extras and not objectValue.empty()) {
+                        addError(result, path + "/extras", "extras", *this, mstr("No properties allowed in this object as `extras: false` and no `props` specified"));
                     }
-                } else if (not extras and not objectValue.empty()) {
-                    result[path + "/extras"] = jon({
-                        {"message", mstr("No properties allowed in this object as `extras: false` and no `props` specified")},
-                        {"data", *this},
-                        {"keyword", "extras"},
-                    });
+                    break;
+                }
+                default: {
+                    break;
                 }
             }
 
-            if (schema.has("anyOf")) {
-                const auto & anyOf = schema.schemaAt<arr_t>("anyOf", path);
-
+            if (schema.hasAnyOf) {
                 bool someValid = false;
-                for (const auto & subSchema : anyOf) {
-                    // Not, use `validate`, but not `_validate` as we don't need an error,
-                    //  just the fact that some of `anyOf` variants matched
-                    const auto subSchemaResult = validate(subSchema);
-                    if (subSchemaResult.isNull()) {
+                for (const auto & subSchema : schema.anyOf) {
+                    if (satisfies(subSchema)) {
                         someValid = true;
                         break;
                     }
                 }
                 if (not someValid) {
-                    result[path + "/anyOf"] = jon({
-                        {"message", "Does not match `anyOf` schemas"},
-                        {"data", {}},
-                        {"keyword", "anyOf"},
-                    });
+                    addError(result, path + "/anyOf", "anyOf", obj(), "Does not match `anyOf` schemas");
                 }
             }
 
-            if (schema.has("oneOf")) {
-                const auto & oneOf = schema.schemaAt<arr_t>("oneOf", path);
-
+            if (schema.hasOneOf) {
                 bool oneValid = false;
-                for (const auto & subSchema : oneOf) {
-                    const auto & subSchemaResult = validate(subSchema);
-                    if (subSchemaResult.isNull()) {
+                for (const auto & subSchema : schema.oneOf) {
+                    if (satisfies(subSchema)) {
                         if (oneValid) {
-                            result[path + "/oneOf"] = jon({
-                                {"message", "Matches more than `oneOf` schemas"},
-                                {"data", {}},
-                                {"keyword", "anyOf"},
-                            });
+                            addError(result, path + "/oneOf", "anyOf", obj(), "Matches more than `oneOf` schemas");
                         }
                         oneValid = true;
                         break;
                     }
                 }
                 if (not oneValid) {
-                    result[path + "/oneOf"] = jon({
-                        {"message", "Does not match any of `oneOf` schemas"},
-                        {"data", {}},
-                        {"keyword", "oneOf"},
-                    });
+                    addError(result, path + "/oneOf", "oneOf", obj(), "Does not match any of `oneOf` schemas");
                 }
             }
 
-            if (schema.has("allOf")) {
-                const auto & allOf = schema.schemaAt<arr_t>("allOf", path);
-
-                for (const auto & subSchema : allOf) {
-                    const auto & subSchemaResult = validate(subSchema);
-                    if (not subSchemaResult.isNull()) {
-                        result[path + "/allOf"] = jon({
-                            {"message", "Does not `allOf` schemas"},
-                            {"data", {}},
-                            {"keyword", "allOf"},
-                        });
+            if (schema.hasAllOf) {
+                for (const auto & subSchema : schema.allOf) {
+                    if (not satisfies(subSchema)) {
+                        addError(result, path + "/allOf", "allOf", obj(), "Does not `allOf` schemas");
                         break;
                     }
                 }
             }
 
-            if (schema.has("not")) {
-                if (schema.at("not").isArray()) {
-                    for (const auto & subSchema : schema.schemaAt<arr_t>("not", path)) {
-                        const auto & subSchemaResult = validate(subSchema);
-                        if (subSchemaResult.isNull()) {
-                            result[path + "/not"] = jon({
-                                {"message", "Matches some of `not` schemas"},
-                                {"data", {}},
-                                {"keyword", "not"},
-                            });
-                            break;
-                        }
-                    }
-                } else {
-                    if (validate(schema.at("not")).isNull()) {
-                        result[path + "/not"] = jon({
-                            {"message", "Matches `not` schema"},
-                            {"data", {}},
-                            {"keyword", "not"},
-                        });
+            if (schema.hasNot) {
+                for (const auto & subSchema : schema.notSchemas) {
+                    if (satisfies(subSchema)) {
+                        addError(result, path + "/not", "not", obj(), schema.notIsArray ? "Matches some of `not` schemas" : "Matches `not` schema");
+                        break;
                     }
                 }
             }
@@ -1389,9 +1782,12 @@ namespace jacylang {
             }
 
             if (isObject()) {
-                jon list {arr_t {}};
-                for (const auto & entry : flatten().get<obj_t>()) {
-                    list.push(jon {str_t {mstr(entry.first, ": ", entry.second.dump())}});
+                jon list(arr_t {});
+                // Keep the flattened result alive for the whole loop -- `get` returns
+                // a reference into it, thus iterating the temporary directly dangles
+                const auto flat = flatten();
+                for (const auto & entry : flat.get<obj_t>()) {
+                    list.push(jon(str_t {mstr(entry.first, ": ", entry.second.dump())}));
                 }
                 return list;
             }
@@ -1404,22 +1800,49 @@ namespace jacylang {
         }
 
     private:
-        static Type getTypeByName(const std::string & name, const std::string & path) {
-            static const std::map<std::string, jon::Type> typeNames = {
-                {"null",   jon::Type::Null},
-                {"bool",   jon::Type::Bool},
-                {"int",    jon::Type::Int},
-                {"float",  jon::Type::Float},
-                {"string", jon::Type::String},
-                {"object", jon::Type::Object},
-                {"array",  jon::Type::Array},
-            };
+        static Type getTypeByName(std::string_view name, const std::string & path) {
+            // The seven type names begin with distinct letters, thus the first character
+            // is a perfect hash: one switch plus a single full comparison against the
+            // `typeNames` table rejecting misspellings, with no hash-map machinery behind it
+            std::optional<Type> found;
+            switch (name.empty() ? '\0' : name.front()) {
+                case 'n': {
+                    found = Type::Null;
+                    break;
+                }
+                case 'b': {
+                    found = Type::Bool;
+                    break;
+                }
+                case 'i': {
+                    found = Type::Int;
+                    break;
+                }
+                case 'f': {
+                    found = Type::Float;
+                    break;
+                }
+                case 's': {
+                    found = Type::String;
+                    break;
+                }
+                case 'o': {
+                    found = Type::Object;
+                    break;
+                }
+                case 'a': {
+                    found = Type::Array;
+                    break;
+                }
+                default: {
+                    break;
+                }
+            }
 
-            const auto & foundType = typeNames.find(name);
-            if (foundType == typeNames.end()) {
-                throw invalid_schema("unknown `type` '" + name + "'", path + "/type");
+            if (found and name == typeNames[static_cast<size_t>(*found)]) {
+                return *found;
             }
-            return foundType->second;
+            throw invalid_schema(mstr("unknown `type` '", name, "'"), path + "/type");
         }
 
         template<class T>
@@ -1464,6 +1887,16 @@ namespace jacylang {
                 throw invalid_schema(mstr(key, " must be ", typeStrArticle<T>()), path + "/" + key);
             }
         }
+
+        /// `schemaAt` counterpart for a node already located with `tryGet`
+        template<class T>
+        static const T & schemaAs(const jon & node, const str_t & key, const std::string & path) {
+            try {
+                return node.get<T>();
+            } catch (type_error & te) {
+                throw invalid_schema(mstr(key, " must be ", typeStrArticle<T>()), path + "/" + key);
+            }
+        }
     };
 
     namespace literal {
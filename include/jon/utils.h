@@ -2,6 +2,7 @@
 #define JON_UTILS_H
 
 #include <string>
+#include <string_view>
 #include <sstream>
 
 #include "error.h"
@@ -77,6 +78,13 @@ namespace jacylang {
         return res;
     }
 
+    static inline std::string_view rtrim(std::string_view s) {
+        while (not s.empty() and std::isspace(static_cast<unsigned char>(s.back()))) {
+            s.remove_suffix(1);
+        }
+        return s;
+    }
+
     static inline uint8_t hexChar2Int(char c) {
         if (c >= '0' and c <= '9') {
             return static_cast<uint8_t>(c - '0');
@@ -138,6 +146,16 @@ namespace jacylang {
     constexpr bool cmp_greater_equal(T t, U u) noexcept {
         return !cmp_less(t, u);
     }
+
+    /// Inclusive `lo <= v <= hi` as a single unsigned compare: shifting everything
+    /// by `lo` wraps out-of-range values past `hi - lo`, which merges both bound
+    /// checks into one branch. Presumes `lo <= hi` -- reversed bounds wrap the
+    /// distance around and admit values neither bound allows, thus callers must
+    /// fall back to separate compares for contradictory ranges
+    constexpr bool cmp_in_range(int64_t v, int64_t lo, int64_t hi) noexcept {
+        return static_cast<uint64_t>(v) - static_cast<uint64_t>(lo)
+            <= static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+    }
 }
 
 #endif // JON_UTILS_H
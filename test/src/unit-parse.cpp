@@ -0,0 +1,72 @@
+#include "doctest/doctest.h"
+#include "jon/jon.h"
+
+using jon = jacylang::jon;
+
+TEST_CASE("string termination") {
+    SUBCASE("single-line strings must not span lines") {
+        CHECK_THROWS_AS(jon::parse("'abc\ndef'\n"), jacylang::parse_error);
+    }
+
+    SUBCASE("multi-line strings span lines") {
+        CHECK(jon::parse("'''a\nb'''\n") == "a\nb");
+    }
+
+    SUBCASE("unterminated strings throw instead of running off the input") {
+        CHECK_THROWS_AS(jon::parse("'oops"), jacylang::parse_error);
+        CHECK_THROWS_AS(jon::parse("'''never closed"), jacylang::parse_error);
+    }
+}
+
+TEST_CASE("comments") {
+    SUBCASE("nested block comments terminate at their own depth") {
+        const auto val = jon::parse("a: 1 /* c /* nested */ still */\nb: 2\n");
+        CHECK(val.at("a") == 1);
+        CHECK(val.at("b") == 2);
+    }
+
+    SUBCASE("unterminated block comment errors instead of hanging") {
+        CHECK_THROWS_AS(jon::parse("/* never closed"), jacylang::parse_error);
+    }
+}
+
+TEST_CASE("integer literal bases") {
+    SUBCASE("binary literals are read base-2") {
+        CHECK(jon::parse("0b1010\n") == 10);
+        CHECK(jon::parse("0B11\n") == 3);
+    }
+
+    SUBCASE("octal and hex literals") {
+        CHECK(jon::parse("0o777\n") == 511);
+        CHECK(jon::parse("0xfF\n") == 255);
+    }
+
+    SUBCASE("digit separators") {
+        CHECK(jon::parse("1_000_000\n") == 1000000);
+        CHECK(jon::parse("0b1_0\n") == 2);
+    }
+
+    SUBCASE("int64 boundary literals") {
+        CHECK(jon::parse("9223372036854775807\n") == std::numeric_limits<jon::int_t>::max());
+        CHECK(jon::parse("-9223372036854775808\n") == std::numeric_limits<jon::int_t>::min());
+    }
+}
+
+TEST_CASE("string escapes") {
+    SUBCASE("hex escapes decode their code point") {
+        CHECK(jon::parse("'\\x41\\x42'\n") == "AB");
+    }
+
+    SUBCASE("octal escapes decode their code point") {
+        CHECK(jon::parse("'\\101\\102'\n") == "AB");
+    }
+
+    SUBCASE("unicode escapes decode big-endian byte pairs") {
+        CHECK(jon::parse("'\\u00e9'\n") == std::string("\x00\xe9", 2));
+    }
+
+    SUBCASE("single-character escapes") {
+        CHECK(jon::parse("'a\\nb'\n") == "a\nb");
+        CHECK(jon::parse("'q\\'q'\n") == "q'q");
+    }
+}
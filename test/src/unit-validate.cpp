@@ -0,0 +1,62 @@
+#include "doctest/doctest.h"
+#include "jon/jon.h"
+
+using jon = jacylang::jon;
+
+TEST_CASE("validation error results") {
+    const auto schema = jon::parse("type: 'object'\nprops: {age: {type: 'int', minInt: 0, maxInt: 150}}\n");
+
+    SUBCASE("failing validation builds a readable error entry") {
+        const auto result = jon::parse("age: 200\n").validate(schema);
+        const auto & entry = result.at("/age").at("/age/maxInt");
+        CHECK(entry.strAt("keyword") == "maxInt");
+        CHECK(entry.at("data") == 200);
+        CHECK(entry.strAt("message").find("greater than 150") != std::string::npos);
+    }
+
+    SUBCASE("type mismatch reports against the expected type") {
+        const auto result = jon::parse("5\n").validate(jon::parse("type: 'string'\n"));
+        CHECK(result.at("/type").strAt("keyword") == "type");
+    }
+
+    SUBCASE("toErrorList renders one line per flattened leaf") {
+        const auto result = jon::parse("age: 200\n").validate(schema);
+        const auto list = result.toErrorList();
+        // One failed constraint carries data, keyword and message leaves
+        CHECK(list.size() == 3);
+        for (size_t i = 0; i < list.size(); i++) {
+            CHECK(list.at(i).isString());
+        }
+    }
+
+    SUBCASE("missing required property is a proper entry") {
+        const auto result = jon::parse("{}\n").validate(schema);
+        CHECK(result.at("/age").strAt("keyword") == "props");
+    }
+}
+
+TEST_CASE("flatten") {
+    SUBCASE("array elements flatten under their own indices") {
+        const auto flat = jon::parse("a: [1, 2]\n").flatten();
+        CHECK(flat.at("/a/0") == 1);
+        CHECK(flat.at("/a/1") == 2);
+    }
+
+    SUBCASE("nested objects flatten to ref-string keys") {
+        const auto flat = jon::parse("a: {b: {c: 3}}\n").flatten();
+        CHECK(flat.at("/a/b/c") == 3);
+    }
+}
+
+TEST_CASE("object-projection initializer entries") {
+    // Regression: building entries through `jon_ref` used to recurse infinitely,
+    // and a `nullptr`-initialized ref landed in the string conversion
+    const jon entry {
+        {"message", "msg"},
+        {"data", jon::parse("200\n")},
+        {"keyword", "maxInt"},
+    };
+    CHECK(entry.isObject());
+    CHECK(entry.strAt("message") == "msg");
+    CHECK(entry.at("data") == 200);
+}